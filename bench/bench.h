@@ -0,0 +1,368 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:39:08 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:17:17 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+# include "includes/minitalk_bonus.h"
+# include <sys/wait.h>
+# include <sys/time.h>
+
+/**
+ * @brief Corpus of the throughput benchmark.
+ *
+ * Every kind of content is sent at every size from 1 byte to BENCH_MAX_SIZE
+ * (x16 each step). Random bytes are drawn from 1..255: a message ends at
+ * its first NUL byte.
+ */
+# define BENCH_MAX_SIZE 1048576
+# define CORPUS_ASCII 0
+# define CORPUS_UTF8 1
+# define CORPUS_BINARY 2
+# define CORPUS_KINDS 3
+
+/**
+ * @brief Limits of one benchmark run.
+ *
+ * A server has BENCH_START_MS to print its PID and a client BENCH_TIMEOUT_MS
+ * to deliver its message; each measurement keeps the median of at most
+ * BENCH_RUNS_MAX runs.
+ */
+# define BENCH_START_MS 2000
+# define BENCH_TIMEOUT_MS 5000
+# define BENCH_RUNS_MAX 15
+
+# define BENCH_MODES 7
+
+/**
+ * @brief Concurrency benchmark (`bench/concurrency`).
+ *
+ * Up to SWARM_MAX clients send SWARM_SIZE bytes each to one server, at the
+ * same time, from 1 client to SWARM_CLIENTS by doubling steps.
+ */
+# define SWARM_MAX 64
+# define SWARM_CLIENTS 8
+# define SWARM_SIZE 1024
+
+/**
+ * @brief Ways of waiting for a signal compared by `bench/pingpong`.
+ *
+ * - WAIT_PAUSE       → handler sets a flag, `pause()` until it is set (the
+ *                      loop of `send_char()`); a signal landing between the
+ *                      check and `pause()` is only noticed at the next tick
+ *                      of a PINGPONG_TICK_US watchdog timer
+ * - WAIT_SIGSUSPEND  → same flag, checked with the signal blocked and
+ *                      waited for with `sigsuspend()`
+ * - WAIT_SIGWAITINFO → signal blocked and taken with `sigwaitinfo()`
+ * - WAIT_SIGNALFD    → signal blocked and read from a signalfd
+ */
+# define WAIT_PAUSE 0
+# define WAIT_SIGSUSPEND 1
+# define WAIT_SIGWAITINFO 2
+# define WAIT_SIGNALFD 3
+# define WAIT_METHODS 4
+
+/**
+ * @brief Round trips measured by `bench/pingpong` per waiting method,
+ * after PINGPONG_WARMUP unmeasured ones.
+ */
+# define PINGPONG_COUNT 1000000
+# define PINGPONG_WARMUP 10000
+# define PINGPONG_TICK_US 1000
+
+/**
+ * @brief Protocol simulator (`bench/simulate`).
+ *
+ * Each configuration sends SIM_RUNS messages of SIM_SIZE bytes by default,
+ * with a window of SIM_WINDOW frames over a link of SIM_DELAY_NS.
+ * At most SIM_EVENTS signals are in flight at once; a run that takes more
+ * than SIM_BUDGET events per bit of the message is reported as stalled.
+ * Events are delivered to the server (SIM_TO_SERVER) or to the client
+ * (SIM_TO_CLIENT).
+ */
+# define SIM_RUNS 10000
+# define SIM_SIZE 64
+# define SIM_WINDOW 16
+# define SIM_DELAY_NS 2000
+# define SIM_EVENTS 4096
+# define SIM_BUDGET 64
+# define SIM_TO_SERVER 0
+# define SIM_TO_CLIENT 1
+
+/**
+ * @brief One client/server pairing under test.
+ *
+ * `flag` is the client flag selecting the transport (NULL for none) and
+ * `bonus` is set when the message is given on standard input (`-`).
+ */
+typedef struct s_mode
+{
+	const char	*name;
+	const char	*server;
+	const char	*client;
+	const char	*flag;
+	int			bonus;
+	size_t		max_size;
+}	t_mode;
+
+/**
+ * @brief Options and scratch files of a benchmark.
+ *
+ * `json` is the file descriptor of the JSON report written to `json_path`
+ * (-1 for none), `only`
+ * the name of the single mode to run (NULL for all of them) and `in` the
+ * file holding the message being sent, at `in_path`. `bench/concurrency`
+ * runs up to `clients` clients with messages of `max_size` bytes.
+ */
+typedef struct s_bench
+{
+	int		runs;
+	int		clients;
+	int		json;
+	char	*json_path;
+	int		first;
+	char	*only;
+	size_t	max_size;
+	int		in;
+	char	*in_path;
+	char	*out_path;
+}	t_bench;
+
+/**
+ * @brief Result of one measurement (median wall time of its runs).
+ *
+ * `client` and `server` add up the cost of the processes over the `runs`
+ * runs (see `cost_add()`), and `signals` the signals the server received
+ * (see `target_stop()`).
+ */
+typedef struct s_result
+{
+	const char		*mode;
+	const char		*corpus;
+	size_t			size;
+	long			wall_ns;
+	unsigned long	signals;
+	int				ok;
+	int				runs;
+	t_cost			client;
+	t_cost			server;
+}	t_result;
+
+/**
+ * @brief Signal a process waits for, with one of the WAIT_* methods.
+ *
+ * `unblocked` is the signal mask `sigsuspend()` waits with and `fd` the
+ * signalfd of WAIT_SIGNALFD.
+ */
+typedef struct s_wait
+{
+	int			method;
+	int			sig;
+	sigset_t	set;
+	sigset_t	unblocked;
+	int			fd;
+}	t_wait;
+
+/**
+ * @brief Options of `bench/pingpong`.
+ *
+ * `method` is the only WAIT_* method to measure (-1 for all of them) and
+ * `cpus` the CPUs of the pinging and echoing processes (-1: not pinned).
+ * `latency` holds the round trips of the method being measured.
+ */
+typedef struct s_pingpong
+{
+	size_t	count;
+	int		method;
+	int		cpus[2];
+	t_hist	latency;
+}	t_pingpong;
+
+/**
+ * @brief Clients of one step of the concurrency benchmark.
+ *
+ * Client i sends `msgs[i]` from the memfd `ins[i]`. `start[i]` and
+ * `end[i]` are its start and exit times, and `ok[i]` tells whether it
+ * exited with status 0 before the timeout.
+ */
+typedef struct s_swarm
+{
+	const t_mode	*mode;
+	int				count;
+	size_t			size;
+	char			*msgs[SWARM_MAX];
+	int				ins[SWARM_MAX];
+	pid_t			pids[SWARM_MAX];
+	long			start[SWARM_MAX];
+	long			end[SWARM_MAX];
+	int				ok[SWARM_MAX];
+}	t_swarm;
+
+/**
+ * @brief Server under test: its PID, output file and what it printed
+ * before the first message.
+ *
+ * `cost` is the cost of the server, from its start to `target_stop()`, and
+ * `client` that of the last client run against it (see `client_run()`).
+ * `signals` is the number of signals the server received, read from its
+ * metrics by `target_stop()`.
+ */
+typedef struct s_target
+{
+	pid_t			pid;
+	int				out;
+	off_t			header;
+	t_cost			cost;
+	t_cost			client;
+	unsigned long	signals;
+}	t_target;
+
+/**
+ * @brief One signal in flight in the simulator, due at `at_ns`.
+ *
+ * `seq` orders events due at the same time, so a run only depends on the
+ * seed.
+ */
+typedef struct s_sim_event
+{
+	long			at_ns;
+	unsigned long	seq;
+	int				to;
+	int				sig;
+	int				value;
+}	t_sim_event;
+
+/**
+ * @brief Simulated transport between one client and one server.
+ *
+ * Every signal is delayed by `delay_ns` plus up to `jitter_ns` (so signals
+ * may overtake each other), lost with a probability of `loss_ppm` per
+ * million and duplicated with a probability of `dup_ppm`. With `coalesce`,
+ * SIGUSR1 or SIGUSR2 sent while the same signal is still pending for the
+ * same process is merged into it, as the kernel does. `events` is a binary
+ * heap of the signals in flight, by due time; `pending` counts the SIGUSR1
+ * and SIGUSR2 in flight towards each side.
+ */
+typedef struct s_link
+{
+	long			delay_ns;
+	long			jitter_ns;
+	int				loss_ppm;
+	int				dup_ppm;
+	int				coalesce;
+	unsigned long	random;
+	long			now_ns;
+	unsigned long	seq;
+	int				count;
+	int				pending[2][2];
+	t_sim_event		events[SIM_EVENTS];
+}	t_link;
+
+/**
+ * @brief Simulated client: an encoder and a retransmitting send window.
+ *
+ * Up to `window` signals may wait for an acknowledgment; they are kept in
+ * `flight`. When nothing is acknowledged for `rto_ns` (0: never), every
+ * signal in flight is sent again (go-back-N). `deadline_ns` is that
+ * timeout (0: none) and `complete` is set by the completion signal.
+ */
+typedef struct s_sim_client
+{
+	t_encoder		enc;
+	t_record		flight[WINDOW_MAX];
+	unsigned long	sent;
+	unsigned long	acked;
+	int				window;
+	long			rto_ns;
+	long			deadline_ns;
+	int				complete;
+}	t_sim_client;
+
+/**
+ * @brief Options and totals of `bench/simulate`.
+ *
+ * `mode` is the only ENCODE_* encoding to simulate (-1 for all of them)
+ * and `rto_ns` the retransmission timeout (-1: that of the real client,
+ * ACK_TIMEOUT_NS for the bit encoding and none for the others). The
+ * server is the real decoder (`session_feed()`) acknowledging like
+ * `handle_record()`; `delivered` is 1 or 0 once it completed a message,
+ * depending on whether it matches `message`, and -1 before.
+ */
+typedef struct s_sim
+{
+	t_link			link;
+	t_sim_client	client;
+	t_session		session;
+	int				mode;
+	int				window;
+	long			rto_ns;
+	int				runs;
+	size_t			size;
+	unsigned long	seed;
+	char			*message;
+	int				delivered;
+	unsigned long	intact;
+	unsigned long	corrupt;
+	unsigned long	stalled;
+	unsigned long	signals;
+	unsigned long	retransmits;
+	unsigned long	events;
+	long			sim_ns;
+}	t_sim;
+
+const t_mode	*mode_get(int index);
+
+char	*corpus_fill(int kind, size_t size);
+char	*corpus_name(int kind);
+
+long	now_ns(void);
+void	samples_sort(long *samples, size_t count);
+long	median_ns(long *times, int count);
+void	cost_add(t_cost *sum, t_cost *cost);
+
+int		target_start(t_target *target, const t_mode *mode, char *out_path);
+void	target_stop(t_target *target);
+pid_t	client_spawn(const t_mode *mode, pid_t server, const char *msg,
+			int in);
+long	client_run(const t_mode *mode, t_target *target, const char *msg,
+			int in);
+void	pin_cpu(int cpu);
+int		target_check(t_target *target, const char *msg, size_t size);
+
+void	wait_setup(t_wait *wait, int method, int sig, pid_t peer);
+void	wait_signal(t_wait *wait);
+void	wait_teardown(t_wait *wait);
+const char	*wait_name(int method);
+int		parse_pingpong(int argc, char **argv, t_pingpong *pp);
+
+int				parse_simulate(int argc, char **argv, t_sim *sim);
+const char		*sim_mode_name(int mode);
+unsigned long	sim_random(t_link *link);
+void			sim_send(t_link *link, int to, int sig, int value);
+int				sim_pop(t_link *link, t_sim_event *ev);
+void			sim_pump(t_sim *sim);
+void			sim_timeout(t_sim *sim);
+void			sim_client_receive(t_sim *sim, int sig, int value);
+void			sim_server_receive(t_sim *sim, int sig, int value);
+int				sim_step(t_sim *sim);
+
+int		swarm_start(t_swarm *swarm, pid_t server);
+void	swarm_wait(t_swarm *swarm);
+int		swarm_finish(t_swarm *swarm, t_target *target);
+
+void	report_edge(int fd, int json, int begin);
+void	report_row(int fd, t_result *res, int json, int first);
+void	report_number(unsigned long n, int fd);
+void	report_field(int fd, int json, const char *name, const char *text);
+void	report_cost(int fd, int json, t_result *res);
+
+#endif
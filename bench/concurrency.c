@@ -0,0 +1,191 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   concurrency.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:49:54 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Sums up the completion times of the clients of a step.
+ *
+ * Fills `t` with the first start and the last exit, and the sum and the
+ * maximum of the completion times of the clients that succeeded.
+ *
+ * @return Jain's fairness index of the client throughputs, in thousandths:
+ *         (sum x)^2 / (n * sum x^2), where x is the throughput of a client
+ *         (0 for a failed one); 1000 when all clients get the same share,
+ *         1000 / n when one client gets everything.
+ */
+static unsigned int	swarm_times(t_swarm *swarm, long *t)
+{
+	double	x[3];
+	long	time;
+	int		i;
+
+	ft_bzero(t, 4 * sizeof(long));
+	ft_bzero(x, sizeof(x));
+	t[0] = swarm->start[0];
+	t[1] = t[0] + 1;
+	i = 0;
+	while (i < swarm->count)
+	{
+		if (swarm->end[i] > t[1])
+			t[1] = swarm->end[i];
+		time = (swarm->end[i] - swarm->start[i]) * swarm->ok[i];
+		t[2] += time;
+		if (time > t[3])
+			t[3] = time;
+		x[0] = (double)swarm->size / (time + 1) * swarm->ok[i];
+		x[1] += x[0];
+		x[2] += x[0] * x[0];
+		i++;
+	}
+	if (x[2] == 0)
+		return (0);
+	return ((unsigned int)(x[1] * x[1] * 1000 / (swarm->count * x[2])));
+}
+
+/**
+ * @brief Writes one step as a CSV line.
+ *
+ * Columns: mode, clients, size, wall_us (first start to last exit),
+ * bytes_per_s (intact messages only), completed (clients that exited with
+ * status 0), mean_client_us and max_client_us (completion time of those
+ * clients), fairness (Jain index) and corruption (share of the messages
+ * not found whole in the output).
+ *
+ * @param swarm Step, once all its clients are collected.
+ * @param intact Number of messages found whole in the output.
+ */
+static void	report(t_swarm *swarm, int intact)
+{
+	long			t[4];
+	int				done;
+	int				i;
+	unsigned int	m;
+
+	m = swarm_times(swarm, t);
+	done = 0;
+	i = 0;
+	while (i < swarm->count)
+		done += swarm->ok[i++];
+	ft_printf("%s,%d,%u,%u,%u,%d,%u,%u,", swarm->mode->name, swarm->count,
+		(unsigned int)swarm->size, (unsigned int)((t[1] - t[0]) / 1000),
+		(unsigned int)(intact * swarm->size * 1000000000L / (t[1] - t[0])),
+		done, (unsigned int)(t[2] / 1000 / (done + (done == 0))),
+		(unsigned int)(t[3] / 1000));
+	ft_printf("%u.%u%u%u,", m / 1000, m / 100 % 10, m / 10 % 10, m % 10);
+	m = (swarm->count - intact) * 1000 / swarm->count;
+	ft_printf("%u.%u%u%u\n", m / 1000, m / 100 % 10, m / 10 % 10, m % 10);
+}
+
+/**
+ * @brief Runs the steps of one mode: 1, 2, 4... up to `bench->clients`
+ * clients, each step against a new server.
+ */
+static void	run_mode(t_bench *bench, const t_mode *mode)
+{
+	t_swarm		swarm;
+	t_target	target;
+	int			count;
+	int			intact;
+
+	count = 1;
+	while (count <= bench->clients)
+	{
+		ft_bzero(&swarm, sizeof(t_swarm));
+		swarm.mode = mode;
+		swarm.count = count;
+		swarm.size = bench->max_size;
+		if (!target_start(&target, mode, bench->out_path))
+			ft_error();
+		if (!swarm_start(&swarm, target.pid))
+			ft_error();
+		swarm_wait(&swarm);
+		intact = swarm_finish(&swarm, &target);
+		target_stop(&target);
+		report(&swarm, intact);
+		if (count < bench->clients && count * 2 > bench->clients)
+			count = bench->clients;
+		else
+			count *= 2;
+	}
+}
+
+/**
+ * @brief Parses the options of the benchmark.
+ *
+ * Usage: bench/concurrency [--clients n] [--size n] [--mode name]
+ *
+ * By default every mode is run with SWARM_SIZE-byte messages, from 1 to
+ * SWARM_CLIENTS clients. Messages are at least 8 bytes long, to hold the
+ * tag of their client. On error the usage line is printed.
+ *
+ * @return 1 if the command line is valid, 0 otherwise.
+ */
+static int	parse_swarm(int argc, char **argv, t_bench *bench)
+{
+	int	i;
+
+	bench->clients = SWARM_CLIENTS;
+	bench->max_size = SWARM_SIZE;
+	i = 1;
+	while (i + 1 < argc)
+	{
+		if (ft_strncmp(argv[i], "--clients", 10) == 0)
+			bench->clients = ft_atoi(argv[i + 1]);
+		else if (ft_strncmp(argv[i], "--size", 7) == 0)
+			bench->max_size = ft_atol(argv[i + 1]);
+		else if (ft_strncmp(argv[i], "--mode", 7) == 0)
+			bench->only = argv[i + 1];
+		else
+			return (0);
+		i += 2;
+	}
+	if (i == argc && bench->clients > 0 && bench->clients <= SWARM_MAX
+		&& bench->max_size >= 8)
+		return (1);
+	ft_putendl_fd("Usage: bench/concurrency [--clients n] [--size n] "
+		"[--mode name]", 2);
+	return (0);
+}
+
+/**
+ * @brief Concurrency benchmark.
+ *
+ * For each mode, 1, 2, 4... up to n clients send a message each to one
+ * server at the same time. Steps are reported as CSV on standard output.
+ */
+int	main(int argc, char **argv)
+{
+	t_bench		bench;
+	sigset_t	set;
+	int			i;
+
+	ft_bzero(&bench, sizeof(t_bench));
+	if (!parse_swarm(argc, argv, &bench))
+		return (1);
+	sigemptyset(&set);
+	sigaddset(&set, SIGCHLD);
+	sigprocmask(SIG_BLOCK, &set, NULL);
+	bench.out_path = ft_strjoin("/tmp/minitalk.bench.out.", ft_itoa(getpid()));
+	ft_printf("mode,clients,size,wall_us,bytes_per_s,completed,"
+		"mean_client_us,max_client_us,fairness,corruption\n");
+	i = 0;
+	while (i < BENCH_MODES)
+	{
+		if (!bench.only || ft_strncmp(mode_get(i)->name, bench.only,
+				ft_strlen(bench.only) + 1) == 0)
+			run_mode(&bench, mode_get(i));
+		i++;
+	}
+	unlink(bench.out_path);
+	return (0);
+}
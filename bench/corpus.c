@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   corpus.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:39:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Fills `buf` with printable ASCII, as a text message would be.
+ */
+static void	fill_ascii(char *buf, size_t size)
+{
+	const char	*text;
+	size_t		len;
+	size_t		i;
+
+	text = "The quick brown fox jumps over the lazy dog. ";
+	len = ft_strlen(text);
+	i = 0;
+	while (i < size)
+	{
+		buf[i] = text[i % len];
+		i++;
+	}
+}
+
+/**
+ * @brief Fills `buf` with UTF-8 text of 1 to 4 bytes per character.
+ *
+ * Characters are never cut: the end of the buffer is padded with spaces.
+ */
+static void	fill_utf8(char *buf, size_t size)
+{
+	const unsigned char	*text;
+	size_t				n;
+	size_t				i;
+	size_t				j;
+
+	text = (const unsigned char *)"Ol\xC3\xA1 mundo \xE2\x9C\x93 "
+		"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E \xF0\x9F\x9A\x80 ";
+	i = 0;
+	j = 0;
+	while (i < size)
+	{
+		n = 1 + (text[j] >= 0xC0) + (text[j] >= 0xE0) + (text[j] >= 0xF0);
+		if (i + n <= size)
+			ft_memcpy(buf + i, text + j, n);
+		else
+		{
+			ft_memset(buf + i, ' ', size - i);
+			n = size - i;
+		}
+		i += n;
+		j += n;
+		if (text[j] == '\0')
+			j = 0;
+	}
+}
+
+/**
+ * @brief Fills `buf` with pseudo-random bytes in 1..255 (xorshift32, fixed
+ * seed, so every run sends the same bytes).
+ */
+static void	fill_binary(char *buf, size_t size)
+{
+	unsigned int	x;
+	size_t			i;
+
+	x = 2463534242u;
+	i = 0;
+	while (i < size)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		buf[i] = (char)(x % 255 + 1);
+		i++;
+	}
+}
+
+/**
+ * @brief Builds a message of the corpus.
+ *
+ * @param kind CORPUS_ASCII, CORPUS_UTF8 or CORPUS_BINARY.
+ * @param size Length of the message.
+ * @return The NUL-terminated message (to free), or NULL.
+ */
+char	*corpus_fill(int kind, size_t size)
+{
+	char	*buf;
+
+	buf = malloc(size + 1);
+	if (!buf)
+		return (NULL);
+	if (kind == CORPUS_ASCII)
+		fill_ascii(buf, size);
+	else if (kind == CORPUS_UTF8)
+		fill_utf8(buf, size);
+	else
+		fill_binary(buf, size);
+	buf[size] = '\0';
+	return (buf);
+}
+
+/**
+ * @brief Name of a kind of content, as reported.
+ */
+char	*corpus_name(int kind)
+{
+	if (kind == CORPUS_ASCII)
+		return ("ascii");
+	if (kind == CORPUS_UTF8)
+		return ("utf8");
+	return ("binary");
+}
@@ -0,0 +1,37 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   modes.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:41:10 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:17:17 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Modes under test, from the slowest to the fastest protocol.
+ *
+ * The slow protocols stop at the size they send in a few seconds.
+ */
+static const t_mode	g_modes[BENCH_MODES] = {
+{"mandatory", "./server", "./client", NULL, 0, 4096},
+{"legacy", "./server_bonus", "./client_bonus", "--legacy", 1, 4096},
+{"rt", "./server_bonus", "./client_bonus", "--rt", 1, 65536},
+{"payload", "./server_bonus", "./client_bonus", "--payload", 1,
+	BENCH_MAX_SIZE},
+{"pull", "./server_bonus", "./client_bonus", "--pull", 1, BENCH_MAX_SIZE},
+{"shm", "./server_bonus", "./client_bonus", "--shm", 1, BENCH_MAX_SIZE},
+{"pipe", "./server_bonus", "./client_bonus", "--pipe", 1, BENCH_MAX_SIZE},
+};
+
+/**
+ * @brief Returns the mode at `index` (0 to BENCH_MODES - 1).
+ */
+const t_mode	*mode_get(int index)
+{
+	return (&g_modes[index]);
+}
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pingpong.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:47:05 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Echoing process: answers every SIGUSR1 with a SIGUSR2, forever.
+ *
+ * With the handler methods the echo is sent from the handler, as the
+ * server acknowledges a bit; otherwise it is sent once the signal is taken.
+ */
+static void	echo(t_pingpong *pp, int method)
+{
+	t_wait	wait;
+
+	pin_cpu(pp->cpus[1]);
+	wait_setup(&wait, method, SIGUSR1, getppid());
+	while (1)
+	{
+		wait_signal(&wait);
+		if (method > WAIT_SIGSUSPEND)
+			kill(getppid(), SIGUSR2);
+	}
+}
+
+/**
+ * @brief Pings the echoing process and times every round trip.
+ *
+ * The first PINGPONG_WARMUP round trips are not measured. The others go
+ * to a histogram, whose size does not depend on the number of round trips.
+ */
+static void	ping(t_pingpong *pp, t_wait *wait, pid_t child)
+{
+	size_t	i;
+	long	start;
+
+	i = 0;
+	while (i < pp->count + PINGPONG_WARMUP)
+	{
+		start = now_ns();
+		kill(child, SIGUSR1);
+		wait_signal(wait);
+		if (i >= PINGPONG_WARMUP)
+			ft_hist_record(&pp->latency, now_ns() - start);
+		i++;
+	}
+}
+
+/**
+ * @brief Measures `pp->count` round trips with one waiting method.
+ *
+ * Both signals are blocked before `fork()`, so that neither process can
+ * receive one before it is ready for it.
+ *
+ * @return 1 once the round trips are timed, 0 if the echoing process could
+ *         not be started.
+ */
+static int	measure(t_pingpong *pp, int method)
+{
+	t_wait		wait;
+	sigset_t	set;
+	pid_t		child;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGUSR1);
+	sigaddset(&set, SIGUSR2);
+	sigprocmask(SIG_BLOCK, &set, NULL);
+	ft_hist_reset(&pp->latency);
+	child = fork();
+	if (child == 0)
+		echo(pp, method);
+	if (child < 0)
+		return (0);
+	pin_cpu(pp->cpus[0]);
+	wait_setup(&wait, method, SIGUSR2, child);
+	ping(pp, &wait, child);
+	wait_teardown(&wait);
+	kill(child, SIGKILL);
+	waitpid(child, NULL, 0);
+	return (1);
+}
+
+/**
+ * @brief Writes the latency distribution of one method as a CSV line.
+ *
+ * Columns: wait, count, cpu_ping, cpu_echo, mean_ns, p50_ns, p99_ns,
+ * p999_ns, max_ns. Percentiles are within 1/2^FT_HIST_SUB_BITS of the
+ * exact ones (see `ft_hist_percentile()`); the mean and maximum are exact.
+ */
+static void	report(t_pingpong *pp, int method)
+{
+	ft_printf("%s,%u,%d,%d,%u,%u,%u,%u,%u\n", wait_name(method),
+		(unsigned int)pp->count, pp->cpus[0], pp->cpus[1],
+		(unsigned int)ft_hist_mean(&pp->latency),
+		(unsigned int)ft_hist_percentile(&pp->latency, 5000),
+		(unsigned int)ft_hist_percentile(&pp->latency, 9900),
+		(unsigned int)ft_hist_percentile(&pp->latency, 9990),
+		(unsigned int)ft_hist_percentile(&pp->latency, 10000));
+}
+
+/**
+ * @brief Signal round-trip latency benchmark.
+ *
+ * A process pings another one with SIGUSR1 and waits for its SIGUSR2 echo,
+ * the round trip of one bit of the 1-bit protocol, PINGPONG_COUNT times
+ * per waiting method. Latencies are reported as CSV on standard output.
+ */
+int	main(int argc, char **argv)
+{
+	static t_pingpong	pp;
+	int					method;
+
+	if (!parse_pingpong(argc, argv, &pp))
+		return (1);
+	ft_printf("wait,count,cpu_ping,cpu_echo,mean_ns,p50_ns,p99_ns,"
+		"p999_ns,max_ns\n");
+	method = 0;
+	while (method < WAIT_METHODS)
+	{
+		if ((pp.method < 0 || pp.method == method) && measure(&pp, method))
+			report(&pp, method);
+		method++;
+	}
+	return (0);
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pingpong_args.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:47:54 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Names of the WAIT_* methods, as given to `--wait` and reported.
+ */
+static const char	*g_waits[WAIT_METHODS] = {
+	"pause", "sigsuspend", "sigwaitinfo", "signalfd"
+};
+
+/**
+ * @brief Name of a WAIT_* method.
+ */
+const char	*wait_name(int method)
+{
+	return (g_waits[method]);
+}
+
+/**
+ * @brief Applies one option of the benchmark.
+ *
+ * @param pp Options being filled.
+ * @param flag Option name.
+ * @param value Option value.
+ * @return 1 if the option is valid, 0 otherwise.
+ */
+static int	parse_option(t_pingpong *pp, char *flag, char *value)
+{
+	int	method;
+
+	method = 0;
+	while (method < WAIT_METHODS
+		&& ft_strncmp(g_waits[method], value, 12) != 0)
+		method++;
+	if (ft_strncmp(flag, "--count", 8) == 0)
+		pp->count = ft_atol(value);
+	else if (ft_strncmp(flag, "--wait", 7) == 0 && method < WAIT_METHODS)
+		pp->method = method;
+	else if (ft_strncmp(flag, "--pin", 6) == 0 && ft_strchr(value, ','))
+	{
+		pp->cpus[0] = ft_atoi(value);
+		pp->cpus[1] = ft_atoi(ft_strchr(value, ',') + 1);
+	}
+	else
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Parses the options of the benchmark.
+ *
+ * Usage: bench/pingpong [--count n] [--wait method] [--pin cpu,cpu]
+ *
+ * By default PINGPONG_COUNT round trips are measured with every method,
+ * without pinning. `--wait` measures a single method (pause, sigsuspend,
+ * sigwaitinfo or signalfd) and `--pin` pins the pinging and the echoing
+ * process. On error the usage line is printed.
+ *
+ * @return 1 if the command line is valid, 0 otherwise.
+ */
+int	parse_pingpong(int argc, char **argv, t_pingpong *pp)
+{
+	int	i;
+
+	pp->count = PINGPONG_COUNT;
+	pp->method = -1;
+	pp->cpus[0] = -1;
+	pp->cpus[1] = -1;
+	i = 1;
+	while (i + 1 < argc && parse_option(pp, argv[i], argv[i + 1]))
+		i += 2;
+	if (i == argc && pp->count > 0)
+		return (1);
+	ft_putendl_fd("Usage: bench/pingpong [--count n] [--wait method] "
+		"[--pin cpu,cpu]", 2);
+	return (0);
+}
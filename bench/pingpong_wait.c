@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pingpong_wait.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:46:41 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+volatile sig_atomic_t	g_signaled = 0;
+pid_t					g_peer = 0;
+
+/**
+ * @brief Handler of the WAIT_PAUSE and WAIT_SIGSUSPEND methods.
+ *
+ * A ping (SIGUSR1) is echoed from the handler, as `signal_handler()` of
+ * the server acknowledges a bit; a pong (SIGUSR2) only sets the flag.
+ * SIGALRM is the watchdog of WAIT_PAUSE: it only interrupts `pause()`.
+ */
+static void	on_signal(int sig)
+{
+	if (sig == SIGUSR1)
+		kill(g_peer, SIGUSR2);
+	if (sig != SIGALRM)
+		g_signaled = 1;
+}
+
+/**
+ * @brief Starts the watchdog of WAIT_PAUSE: SIGALRM every PINGPONG_TICK_US.
+ */
+static void	start_watchdog(struct sigaction *sa)
+{
+	struct itimerval	tick;
+
+	sigaction(SIGALRM, sa, NULL);
+	tick.it_interval.tv_sec = 0;
+	tick.it_interval.tv_usec = PINGPONG_TICK_US;
+	tick.it_value = tick.it_interval;
+	setitimer(ITIMER_REAL, &tick, NULL);
+}
+
+/**
+ * @brief Prepares a process to wait for `sig` with one of the methods.
+ *
+ * `sig` must already be blocked (it is, from before `fork()`, so an early
+ * signal stays pending). The methods with a handler install it; WAIT_PAUSE
+ * then unblocks the signal and starts its watchdog timer.
+ *
+ * @param wait Waiting state to fill.
+ * @param method WAIT_* method.
+ * @param sig Signal waited for (SIGUSR1 to echo pings, SIGUSR2 for pongs).
+ * @param peer Process the handler echoes pings to.
+ */
+void	wait_setup(t_wait *wait, int method, int sig, pid_t peer)
+{
+	struct sigaction	sa;
+
+	wait->method = method;
+	wait->sig = sig;
+	sigemptyset(&wait->set);
+	sigaddset(&wait->set, sig);
+	sigprocmask(SIG_BLOCK, NULL, &wait->unblocked);
+	sigdelset(&wait->unblocked, sig);
+	g_peer = peer;
+	ft_bzero(&sa, sizeof(sa));
+	sa.sa_handler = on_signal;
+	if (method <= WAIT_SIGSUSPEND)
+		sigaction(sig, &sa, NULL);
+	wait->fd = -1;
+	if (method == WAIT_SIGNALFD)
+		wait->fd = signalfd(-1, &wait->set, 0);
+	if (method != WAIT_PAUSE)
+		return ;
+	start_watchdog(&sa);
+	sigprocmask(SIG_UNBLOCK, &wait->set, NULL);
+}
+
+/**
+ * @brief Waits for one signal with the method of `wait`.
+ */
+void	wait_signal(t_wait *wait)
+{
+	struct signalfd_siginfo	info;
+	ssize_t					got;
+
+	got = 0;
+	if (wait->method == WAIT_PAUSE)
+		while (!g_signaled)
+			pause();
+	else if (wait->method == WAIT_SIGSUSPEND)
+		while (!g_signaled)
+			sigsuspend(&wait->unblocked);
+	else if (wait->method == WAIT_SIGWAITINFO)
+		while (got != wait->sig)
+			got = sigwaitinfo(&wait->set, NULL);
+	else
+		while (got != sizeof(info))
+			got = read(wait->fd, &info, sizeof(info));
+	g_signaled = 0;
+}
+
+/**
+ * @brief Undoes `wait_setup()`: stops the watchdog, closes the signalfd,
+ * restores the default action and blocks the signal again.
+ */
+void	wait_teardown(t_wait *wait)
+{
+	struct itimerval	off;
+
+	ft_bzero(&off, sizeof(off));
+	setitimer(ITIMER_REAL, &off, NULL);
+	signal(SIGALRM, SIG_DFL);
+	sigprocmask(SIG_BLOCK, &wait->set, NULL);
+	signal(wait->sig, SIG_DFL);
+	if (wait->fd >= 0)
+		close(wait->fd);
+}
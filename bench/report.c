@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   report.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:40:20 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:17:17 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Writes an unsigned number in decimal.
+ */
+void	report_number(unsigned long n, int fd)
+{
+	char	c;
+
+	if (n >= 10)
+		report_number(n / 10, fd);
+	c = '0' + n % 10;
+	write(fd, &c, 1);
+}
+
+/**
+ * @brief Writes the separator and, in JSON, the name of the next field.
+ *
+ * Fields are separated by commas, except before `mode` (the first one).
+ *
+ * @param fd Output file descriptor.
+ * @param json 1 for JSON, 0 for CSV.
+ * @param name Name of the field.
+ * @param text Value of a text field (quoted in JSON), or NULL for a number
+ *             written by the caller.
+ */
+void	report_field(int fd, int json, const char *name, const char *text)
+{
+	if (ft_strncmp(name, "mode", 5) != 0)
+		ft_putchar_fd(',', fd);
+	if (json)
+	{
+		ft_putstr_fd(" \"", fd);
+		ft_putstr_fd((char *)name, fd);
+		ft_putstr_fd("\": ", fd);
+	}
+	if (text && json)
+		ft_putchar_fd('"', fd);
+	if (text)
+		ft_putstr_fd((char *)text, fd);
+	if (text && json)
+		ft_putchar_fd('"', fd);
+}
+
+/**
+ * @brief Writes the timing fields of a measurement.
+ *
+ * Rates are derived from the median wall time (0 for a failed
+ * measurement) and signals are averaged over the runs; signals per byte
+ * is written with three decimals.
+ */
+static void	put_rates(int fd, int json, t_result *res)
+{
+	unsigned long	wall;
+	unsigned long	scale;
+	unsigned long	milli;
+	unsigned long	signals;
+
+	wall = res->wall_ns + (res->wall_ns == 0);
+	scale = 1000000000UL * (res->wall_ns > 0);
+	signals = res->signals / (res->runs + (res->runs == 0));
+	milli = signals * 1000 / res->size;
+	report_field(fd, json, "wall_us", NULL);
+	report_number(wall / 1000, fd);
+	report_field(fd, json, "bytes_per_s", NULL);
+	report_number(res->size * scale / wall, fd);
+	report_field(fd, json, "signals", NULL);
+	report_number(signals, fd);
+	report_field(fd, json, "signals_per_s", NULL);
+	report_number(signals * scale / wall, fd);
+	report_field(fd, json, "signals_per_byte", NULL);
+	report_number(milli / 1000, fd);
+	ft_putchar_fd('.', fd);
+	report_number(milli / 100 % 10, fd);
+	report_number(milli / 10 % 10, fd);
+	report_number(milli % 10, fd);
+}
+
+/**
+ * @brief Opens (CSV header line, JSON array) or closes a report.
+ *
+ * @param fd Output file descriptor (nothing is written if negative).
+ * @param json 1 for JSON, 0 for CSV.
+ * @param begin 1 before the first measurement, 0 after the last one.
+ */
+void	report_edge(int fd, int json, int begin)
+{
+	if (fd < 0)
+		return ;
+	if (json && begin)
+		ft_putstr_fd("[", fd);
+	else if (json)
+		ft_putendl_fd("\n]", fd);
+	else if (begin)
+		ft_putendl_fd("mode,corpus,size,wall_us,bytes_per_s,signals,"
+			"signals_per_s,signals_per_byte,client_vcsw,client_ivcsw,"
+			"client_minflt,client_cycles_per_byte,client_insns_per_byte,"
+			"server_vcsw,server_ivcsw,server_minflt,server_cycles_per_byte,"
+			"server_insns_per_byte,ok", fd);
+}
+
+/**
+ * @brief Writes one measurement as a CSV line or a JSON object.
+ *
+ * @param fd Output file descriptor.
+ * @param res Measurement.
+ * @param json 1 for JSON, 0 for CSV.
+ * @param first 1 for the first measurement of a JSON report.
+ */
+void	report_row(int fd, t_result *res, int json, int first)
+{
+	if (json && !first)
+		ft_putchar_fd(',', fd);
+	if (json)
+		ft_putstr_fd("\n  {", fd);
+	report_field(fd, json, "mode", res->mode);
+	report_field(fd, json, "corpus", res->corpus);
+	report_field(fd, json, "size", NULL);
+	report_number(res->size, fd);
+	put_rates(fd, json, res);
+	report_cost(fd, json, res);
+	report_field(fd, json, "ok", NULL);
+	report_number(res->ok, fd);
+	if (json)
+		ft_putstr_fd(" }", fd);
+	else
+		ft_putchar_fd('\n', fd);
+}
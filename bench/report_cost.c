@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   report_cost.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:13:27 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Writes a count per byte, left empty (null in JSON) if missing.
+ *
+ * @param fd Output file descriptor.
+ * @param json 1 for JSON, 0 for CSV.
+ * @param name Name of the field.
+ * @param value Count per byte, -1 if it was not counted.
+ */
+static void	put_per_byte(int fd, int json, const char *name, long value)
+{
+	report_field(fd, json, name, NULL);
+	if (value >= 0)
+		report_number(value, fd);
+	else if (json)
+		ft_putstr_fd("null", fd);
+}
+
+/**
+ * @brief Writes the cost fields of the client or of the server.
+ *
+ * Context switches and minor faults are means per run; cycles and
+ * instructions are per byte of the message, over all the runs.
+ *
+ * @param fd Output file descriptor.
+ * @param json 1 for JSON, 0 for CSV.
+ * @param res Measurement.
+ * @param server 1 for the server, 0 for the client.
+ */
+static void	put_cost(int fd, int json, t_result *res, int server)
+{
+	static const char	*names[2][5] = {{"client_vcsw", "client_ivcsw",
+		"client_minflt", "client_cycles_per_byte", "client_insns_per_byte"},
+	{"server_vcsw", "server_ivcsw", "server_minflt",
+		"server_cycles_per_byte", "server_insns_per_byte"}};
+	t_cost				*cost;
+	long				runs;
+	long				bytes;
+
+	cost = &res->client;
+	if (server)
+		cost = &res->server;
+	runs = res->runs + (res->runs == 0);
+	bytes = runs * res->size;
+	report_field(fd, json, names[server][0], NULL);
+	report_number(cost->nvcsw / runs, fd);
+	report_field(fd, json, names[server][1], NULL);
+	report_number(cost->nivcsw / runs, fd);
+	report_field(fd, json, names[server][2], NULL);
+	report_number(cost->minflt / runs, fd);
+	put_per_byte(fd, json, names[server][3],
+		cost->cycles / bytes - (cost->cycles < 0));
+	put_per_byte(fd, json, names[server][4],
+		cost->instructions / bytes - (cost->instructions < 0));
+}
+
+/**
+ * @brief Writes the kernel cost of a measurement, client then server.
+ *
+ * Both processes are counted over their whole life, start-up included
+ * (see `client_run()` and `target_stop()`).
+ *
+ * @param fd Output file descriptor.
+ * @param json 1 for JSON, 0 for CSV.
+ * @param res Measurement.
+ */
+void	report_cost(int fd, int json, t_result *res)
+{
+	put_cost(fd, json, res, 0);
+	put_cost(fd, json, res, 1);
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   run.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:40:06 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Waits for a process to exit, for at most BENCH_TIMEOUT_MS.
+ *
+ * The exit is watched with a pidfd, so the wall time is not rounded to
+ * a polling interval. A process that does not exit in time is killed.
+ * Its context switches and page faults are taken from `wait4()`.
+ *
+ * @param pid Process to wait for.
+ * @param cost Cost of the process, updated.
+ * @return 1 if it exited with status 0, 0 otherwise.
+ */
+static int	wait_exit(pid_t pid, t_cost *cost)
+{
+	struct pollfd	pfd;
+	struct rusage	usage;
+	int				status;
+
+	pfd.fd = syscall(SYS_pidfd_open, pid, 0);
+	pfd.events = POLLIN;
+	if (pfd.fd >= 0 && poll(&pfd, 1, BENCH_TIMEOUT_MS) == 0)
+		kill(pid, SIGKILL);
+	if (pfd.fd >= 0)
+		close(pfd.fd);
+	if (wait4(pid, &status, 0, &usage) < 0)
+		return (0);
+	cost_usage(cost, &usage);
+	return (WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+/**
+ * @brief Runs the client of a mode in the child process.
+ *
+ * Bonus clients read the message from `in` (message `-`); the mandatory
+ * client gets it on its command line. The output of the client is
+ * discarded.
+ */
+static void	client_exec(const t_mode *mode, pid_t server, const char *msg,
+		int in)
+{
+	char	*argv[5];
+	int		i;
+	int		null;
+
+	i = 0;
+	argv[i++] = (char *)mode->client;
+	if (mode->flag)
+		argv[i++] = (char *)mode->flag;
+	argv[i++] = ft_itoa(server);
+	argv[i++] = (char *)msg;
+	if (mode->bonus)
+		argv[i - 1] = "-";
+	argv[i] = NULL;
+	null = open("/dev/null", O_WRONLY);
+	dup2(in, 0);
+	dup2(null, 1);
+	execv(argv[0], argv);
+	_exit(127);
+}
+
+/**
+ * @brief Starts the client of a mode, without waiting for it.
+ *
+ * @param mode Mode under test.
+ * @param server PID of the server.
+ * @param msg Message to send.
+ * @param in File holding the message, rewound first.
+ * @return PID of the client, or -1.
+ */
+pid_t	client_spawn(const t_mode *mode, pid_t server, const char *msg,
+		int in)
+{
+	pid_t	child;
+
+	lseek(in, 0, SEEK_SET);
+	child = fork();
+	if (child == 0)
+		client_exec(mode, server, msg, in);
+	return (child);
+}
+
+/**
+ * @brief Runs the client of a mode once, times it and takes its cost.
+ *
+ * The child waits on a pipe until its counters are open, so they count the
+ * client from its `execve()` on, like the wall time (see `cost_open()`).
+ *
+ * @param mode Mode under test.
+ * @param target Server under test (`client` receives the cost).
+ * @param msg Message to send.
+ * @param in File holding the message.
+ * @return Wall time of the client in nanoseconds, or -1 if it failed.
+ */
+long	client_run(const t_mode *mode, t_target *target, const char *msg,
+		int in)
+{
+	long	wall;
+	pid_t	child;
+	int		gate[2];
+	char	go;
+
+	if (pipe2(gate, O_CLOEXEC) < 0)
+		return (-1);
+	lseek(in, 0, SEEK_SET);
+	wall = now_ns();
+	child = fork();
+	if (child == 0 && close(gate[1]) == 0 && read(gate[0], &go, 1) == 0)
+		client_exec(mode, target->pid, msg, in);
+	if (child == 0)
+		_exit(127);
+	cost_open(&target->client, child, 1);
+	close(gate[0]);
+	close(gate[1]);
+	if (child < 0 || !wait_exit(child, &target->client))
+		wall = -1;
+	else
+		wall = now_ns() - wall;
+	cost_read(&target->client);
+	cost_close(&target->client);
+	return (wall);
+}
+
+/**
+ * @brief Pins the calling process to one CPU (nothing if `cpu` is -1).
+ */
+void	pin_cpu(int cpu)
+{
+	cpu_set_t	set;
+
+	if (cpu < 0)
+		return ;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) < 0)
+		ft_putendl_fd("bench: cannot pin to the requested CPU", 2);
+}
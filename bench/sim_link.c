@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sim_link.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:21:38 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:21:38 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Draws the next number of the link's generator (xorshift64*).
+ *
+ * The generator is seeded once per configuration, so every run of the
+ * simulator with the same options makes the same decisions.
+ *
+ * @param link Simulated link (its state is updated).
+ * @return A pseudo-random 64-bit number.
+ */
+unsigned long	sim_random(t_link *link)
+{
+	link->random ^= link->random >> 12;
+	link->random ^= link->random << 25;
+	link->random ^= link->random >> 27;
+	return (link->random * 2685821657736338717UL);
+}
+
+/**
+ * @brief Adds a signal to the heap of signals in flight.
+ *
+ * @param link Simulated link.
+ * @param ev Signal to add (the heap is not full).
+ */
+static void	heap_push(t_link *link, t_sim_event *ev)
+{
+	t_sim_event	*events;
+	int			i;
+
+	events = link->events;
+	i = link->count++;
+	while (i > 0 && (events[(i - 1) / 2].at_ns > ev->at_ns
+			|| (events[(i - 1) / 2].at_ns == ev->at_ns
+				&& events[(i - 1) / 2].seq > ev->seq)))
+	{
+		events[i] = events[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	events[i] = *ev;
+}
+
+/**
+ * @brief Moves the last signal of the heap down from the top.
+ *
+ * @param link Simulated link (its top was just removed).
+ */
+static void	heap_down(t_link *link)
+{
+	t_sim_event	*events;
+	t_sim_event	last;
+	int			i;
+	int			child;
+
+	events = link->events;
+	last = events[link->count];
+	i = 0;
+	child = 1;
+	while (child < link->count)
+	{
+		if (child + 1 < link->count && (events[child + 1].at_ns
+				< events[child].at_ns || (events[child + 1].at_ns
+					== events[child].at_ns && events[child + 1].seq
+					< events[child].seq)))
+			child++;
+		if (last.at_ns < events[child].at_ns || (last.at_ns
+				== events[child].at_ns && last.seq < events[child].seq))
+			break ;
+		events[i] = events[child];
+		i = child;
+		child = 2 * i + 1;
+	}
+	events[i] = last;
+}
+
+/**
+ * @brief Takes the next signal due and advances the clock to it.
+ *
+ * @param link Simulated link.
+ * @param ev Receives the signal.
+ * @return 1 on success, 0 if no signal is in flight.
+ */
+int	sim_pop(t_link *link, t_sim_event *ev)
+{
+	if (link->count == 0)
+		return (0);
+	*ev = link->events[0];
+	link->count--;
+	if (link->count > 0)
+		heap_down(link);
+	link->now_ns = ev->at_ns;
+	if (ev->sig == SIGUSR1 || ev->sig == SIGUSR2)
+		link->pending[ev->to][ev->sig == SIGUSR2]--;
+	return (1);
+}
+
+/**
+ * @brief Sends a signal over the simulated link.
+ *
+ * The signal is lost, duplicated, coalesced with the same signal still
+ * pending, or delayed, as set in `link`; the decisions are drawn from the
+ * link's generator, so a run only depends on the options and the seed.
+ * Past SIM_EVENTS signals in flight, the signal is lost, as with a full
+ * signal queue.
+ *
+ * @param link Simulated link.
+ * @param to SIM_TO_SERVER or SIM_TO_CLIENT.
+ * @param sig Signal number.
+ * @param value Queued value.
+ */
+void	sim_send(t_link *link, int to, int sig, int value)
+{
+	t_sim_event	ev;
+	int			copies;
+	int			lost;
+	int			merge;
+
+	lost = (long)(sim_random(link) % 1000000) < link->loss_ppm;
+	copies = 1 + ((long)(sim_random(link) % 1000000) < link->dup_ppm);
+	merge = link->coalesce && (sig == SIGUSR1 || sig == SIGUSR2);
+	while (!lost && copies > 0)
+	{
+		copies--;
+		ev.at_ns = link->now_ns + link->delay_ns
+			+ sim_random(link) % (link->jitter_ns + 1);
+		if ((merge && link->pending[to][sig == SIGUSR2])
+			|| link->count == SIM_EVENTS)
+			continue ;
+		ev.seq = link->seq++;
+		ev.to = to;
+		ev.sig = sig;
+		ev.value = value;
+		heap_push(link, &ev);
+		if (sig == SIGUSR1 || sig == SIGUSR2)
+			link->pending[to][sig == SIGUSR2]++;
+	}
+}
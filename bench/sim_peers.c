@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sim_peers.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:21:56 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:48:48 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Client: sends as many signals as the window allows.
+ *
+ * As in `send_window()`, the first signal is sent alone, then up to
+ * `window` signals may wait for an acknowledgment. The symbol encodings
+ * use a window of 1, which is the stop-and-wait of `send_symbol()`. The
+ * retransmission timer starts when a signal is sent with none in flight.
+ *
+ * @param sim Simulator state.
+ */
+void	sim_pump(t_sim *sim)
+{
+	t_sim_client	*client;
+	t_record		*rec;
+
+	client = &sim->client;
+	while (!client->enc.last
+		&& client->sent - client->acked < (unsigned long)client->window
+		&& (client->sent == 0 || client->acked > 0))
+	{
+		rec = &client->flight[client->sent % WINDOW_MAX];
+		encoder_next(&client->enc, rec);
+		sim_send(&sim->link, SIM_TO_SERVER, rec->sig, rec->value);
+		sim->signals++;
+		if (client->rto_ns > 0 && client->sent == client->acked)
+			client->deadline_ns = sim->link.now_ns + client->rto_ns;
+		client->sent++;
+	}
+}
+
+/**
+ * @brief Client: nothing was acknowledged for `rto_ns`.
+ *
+ * Every signal in flight is sent again (go-back-N), which for the symbol
+ * encodings is the resend of `send_symbol()`. Symbols carry alternating
+ * markers and the decoder skips a repeated one, but frames have no
+ * sequence numbers, so a frame resend whose original was not lost
+ * corrupts the message; this is what the simulator measures.
+ *
+ * @param sim Simulator state.
+ */
+void	sim_timeout(t_sim *sim)
+{
+	t_sim_client	*client;
+	t_record		*rec;
+	unsigned long	i;
+
+	client = &sim->client;
+	i = client->acked;
+	while (i < client->sent)
+	{
+		rec = &client->flight[i % WINDOW_MAX];
+		sim_send(&sim->link, SIM_TO_SERVER, rec->sig, rec->value);
+		sim->signals++;
+		sim->retransmits++;
+		i++;
+	}
+	client->deadline_ns = sim->link.now_ns + client->rto_ns;
+}
+
+/**
+ * @brief Client: handles an acknowledgment or the completion signal.
+ *
+ * Frame acknowledgments carry no sequence number: each one releases the
+ * oldest signal in flight, and one with nothing in flight is ignored. A
+ * symbol acknowledgment carrying another marker than the symbol in flight
+ * is a late one and is ignored too, as in `send_symbol()`.
+ *
+ * @param sim Simulator state.
+ * @param sig SIGUSR1 (message complete), SIGUSR2 or SIG_PAYLOAD_ACK.
+ * @param value Queued value (marker of the acknowledged symbol).
+ */
+void	sim_client_receive(t_sim *sim, int sig, int value)
+{
+	t_sim_client	*client;
+
+	client = &sim->client;
+	if (sig == SIGUSR1)
+		client->complete = 1;
+	if (sig == SIGUSR1 || client->acked == client->sent)
+		return ;
+	if (sig == SIGUSR2
+		&& value != client->flight[client->acked % WINDOW_MAX].value)
+		return ;
+	client->acked++;
+	client->deadline_ns = 0;
+	if (client->rto_ns > 0 && client->acked < client->sent)
+		client->deadline_ns = sim->link.now_ns + client->rto_ns;
+	sim_pump(sim);
+}
+
+/**
+ * @brief Server: feeds a signal to the real decoder and answers it.
+ *
+ * The answers are those of `handle_record()`: SIG_PAYLOAD_ACK for a frame,
+ * SIGUSR2 with its marker for a symbol, SIGUSR1 once the message is
+ * complete and nothing for a signal the decoder refused. The first message
+ * completed is compared with the one sent.
+ *
+ * @param sim Simulator state.
+ * @param sig Signal number.
+ * @param value Queued value.
+ */
+void	sim_server_receive(t_sim *sim, int sig, int value)
+{
+	int	status;
+
+	status = session_feed(&sim->session, sig, value);
+	if (status == FEED_DONE)
+	{
+		if (sim->delivered < 0)
+			sim->delivered = (sim->session.len == sim->size
+					&& ft_memcmp(sim->session.buf, sim->message,
+						sim->size) == 0);
+		session_end(&sim->session);
+		sim_send(&sim->link, SIM_TO_CLIENT, SIGUSR1, 0);
+	}
+	else if (status == FEED_ACK && sig == SIG_PAYLOAD)
+		sim_send(&sim->link, SIM_TO_CLIENT, SIG_PAYLOAD_ACK, 0);
+	else if (status == FEED_ACK)
+		sim_send(&sim->link, SIM_TO_CLIENT, SIGUSR2, value);
+}
+
+/**
+ * @brief Advances the simulation by one event.
+ *
+ * The next event is the client's retransmission timeout if it is due
+ * first, otherwise the next signal in flight, delivered to its side.
+ *
+ * @param sim Simulator state.
+ * @return 1 if an event was processed, 0 if nothing can happen anymore.
+ */
+int	sim_step(t_sim *sim)
+{
+	t_sim_event	ev;
+	long		deadline;
+
+	deadline = sim->client.deadline_ns;
+	if (deadline && (sim->link.count == 0
+			|| deadline <= sim->link.events[0].at_ns))
+	{
+		sim->link.now_ns = deadline;
+		sim_timeout(sim);
+		return (1);
+	}
+	if (!sim_pop(&sim->link, &ev))
+		return (0);
+	if (ev.to == SIM_TO_SERVER)
+		sim_server_receive(sim, ev.sig, ev.value);
+	else
+		sim_client_receive(sim, ev.sig, ev.value);
+	return (1);
+}
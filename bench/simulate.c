@@ -0,0 +1,182 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   simulate.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:22:46 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:22:46 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Gets the link, the client and the server ready for a message.
+ *
+ * The link keeps its generator and the client its window and timeout.
+ *
+ * @param sim Simulator state.
+ */
+static void	sim_reset(t_sim *sim)
+{
+	sim->link.now_ns = 0;
+	sim->link.count = 0;
+	ft_bzero(sim->link.pending, sizeof(sim->link.pending));
+	session_end(&sim->session);
+	encoder_start(&sim->client.enc, sim->message, sim->size, sim->mode);
+	sim->client.sent = 0;
+	sim->client.acked = 0;
+	sim->client.deadline_ns = 0;
+	sim->client.complete = 0;
+	sim->delivered = -1;
+}
+
+/**
+ * @brief Simulates the transfer of one message.
+ *
+ * A message is intact when the client got the completion signal and the
+ * server decoded exactly the message sent, corrupt when the server decoded
+ * something else, and stalled otherwise (nothing left in flight, or more
+ * than SIM_BUDGET events per bit of the message).
+ *
+ * @param sim Simulator state (totals are updated).
+ */
+static void	sim_message(t_sim *sim)
+{
+	unsigned long	budget;
+	unsigned long	events;
+
+	sim_reset(sim);
+	budget = (sim->size + 1) * 8 * SIM_BUDGET;
+	sim_pump(sim);
+	events = 0;
+	while (!sim->client.complete && events < budget && sim_step(sim))
+		events++;
+	sim->events += events;
+	sim->sim_ns += sim->link.now_ns;
+	if (sim->client.complete && sim->delivered == 1)
+		sim->intact++;
+	else if (sim->delivered == 0)
+		sim->corrupt++;
+	else
+		sim->stalled++;
+}
+
+/**
+ * @brief Prints the CSV line of a configuration, after its mode.
+ *
+ * `sim_ns_per_message` is the mean simulated time of a transfer and
+ * `events_per_s` the number of events simulated per second of real time.
+ *
+ * @param sim Simulator state.
+ * @param wall_ns Real time spent simulating the configuration.
+ */
+static void	sim_report(t_sim *sim, long wall_ns)
+{
+	unsigned long	values[15];
+	int				i;
+
+	values[0] = sim->client.window;
+	values[1] = sim->link.delay_ns;
+	values[2] = sim->link.jitter_ns;
+	values[3] = sim->link.loss_ppm;
+	values[4] = sim->link.dup_ppm;
+	values[5] = sim->link.coalesce;
+	values[6] = sim->client.rto_ns;
+	values[7] = sim->runs;
+	values[8] = sim->intact;
+	values[9] = sim->corrupt;
+	values[10] = sim->stalled;
+	values[11] = sim->signals;
+	values[12] = sim->retransmits;
+	values[13] = sim->sim_ns / sim->runs;
+	values[14] = sim->events * 1000000000.0 / (wall_ns + 1);
+	i = 0;
+	while (i < 15)
+	{
+		ft_putchar_fd(',', 1);
+		report_number(values[i++], 1);
+	}
+	ft_putchar_fd('\n', 1);
+}
+
+/**
+ * @brief Simulates `sim->runs` messages with one encoding.
+ *
+ * The symbol encodings are stop-and-wait (a window of 1). Unless `--rto`
+ * is given, the timeout is that of the real client: ACK_TIMEOUT_NS for
+ * the bits, whose signals may be merged, and none for the real-time
+ * encodings, whose signals are queued.
+ *
+ * @param sim Simulator state (a copy of the options).
+ * @param mode ENCODE_* encoding.
+ */
+static void	sim_config(t_sim *sim, int mode)
+{
+	long	start;
+	int		i;
+
+	sim->mode = mode;
+	sim->client.window = 1;
+	if (mode == ENCODE_FRAMES)
+		sim->client.window = sim->window;
+	sim->client.rto_ns = sim->rto_ns;
+	if (sim->rto_ns < 0)
+		sim->client.rto_ns = (mode == ENCODE_BITS) * ACK_TIMEOUT_NS;
+	sim->link.random = sim->seed;
+	start = now_ns();
+	i = 0;
+	while (i < sim->runs)
+	{
+		sim_message(sim);
+		i++;
+	}
+	ft_putstr_fd((char *)sim_mode_name(mode), 1);
+	sim_report(sim, now_ns() - start);
+	session_end(&sim->session);
+}
+
+/**
+ * @brief Entry point of the protocol simulator.
+ *
+ * The client's encoder (`encoder_next()`) and the server's decoder
+ * (`session_feed()`) exchange signals over a simulated link, in a single
+ * process and without a single real signal, so loss, duplication,
+ * reordering and merged signals can be studied deterministically, and
+ * window and retransmission strategies compared, at millions of signals
+ * per second. Every configuration sends the same random binary message
+ * and prints one CSV line.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector (see `parse_simulate()`).
+ * @return 0 on success, 1 on a usage error.
+ */
+int	main(int argc, char **argv)
+{
+	static t_sim	options;
+	static t_sim	sim;
+	int				mode;
+
+	if (!parse_simulate(argc, argv, &options))
+		return (1);
+	options.message = corpus_fill(CORPUS_BINARY, options.size);
+	if (!options.message)
+		ft_error();
+	ft_printf("mode,window,delay_ns,jitter_ns,loss_ppm,dup_ppm,coalesce,"
+		"rto_ns,runs,intact,corrupt,stalled,signals,retransmits,"
+		"sim_ns_per_message,events_per_s\n");
+	mode = ENCODE_BITS;
+	while (mode <= ENCODE_FRAMES)
+	{
+		if (options.mode < 0 || options.mode == mode)
+		{
+			sim = options;
+			sim_config(&sim, mode);
+		}
+		mode++;
+	}
+	free(options.message);
+	return (0);
+}
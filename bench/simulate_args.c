@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   simulate_args.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:22:46 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:22:46 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Names of the ENCODE_* encodings, as given to `--mode` and
+ * reported (the client flag that selects each one).
+ */
+static const char	*g_sim_modes[3] = {
+	"legacy", "rt", "payload"
+};
+
+/**
+ * @brief Name of an ENCODE_* encoding.
+ */
+const char	*sim_mode_name(int mode)
+{
+	return (g_sim_modes[mode]);
+}
+
+/**
+ * @brief Applies one option of the simulated link.
+ *
+ * @param link Link being configured.
+ * @param flag Option name.
+ * @param value Option value.
+ * @return 1 if the option is valid, 0 otherwise.
+ */
+static int	parse_link(t_link *link, char *flag, char *value)
+{
+	if (ft_strncmp(flag, "--delay", 8) == 0)
+		link->delay_ns = ft_atol(value);
+	else if (ft_strncmp(flag, "--jitter", 9) == 0)
+		link->jitter_ns = ft_atol(value);
+	else if (ft_strncmp(flag, "--loss", 7) == 0)
+		link->loss_ppm = ft_atoi(value);
+	else if (ft_strncmp(flag, "--dup", 6) == 0)
+		link->dup_ppm = ft_atoi(value);
+	else
+		return (0);
+	return (link->delay_ns >= 0 && link->jitter_ns >= 0);
+}
+
+/**
+ * @brief Applies one option of the simulator.
+ *
+ * @param sim Options being filled.
+ * @param flag Option name.
+ * @param value Option value.
+ * @return 1 if the option is valid, 0 otherwise.
+ */
+static int	parse_option(t_sim *sim, char *flag, char *value)
+{
+	int	mode;
+
+	mode = 0;
+	while (mode < 3 && ft_strncmp(g_sim_modes[mode], value, 8) != 0)
+		mode++;
+	if (ft_strncmp(flag, "--mode", 7) == 0 && mode < 3)
+		sim->mode = mode;
+	else if (ft_strncmp(flag, "--window", 9) == 0)
+		sim->window = ft_atoi(value);
+	else if (ft_strncmp(flag, "--runs", 7) == 0)
+		sim->runs = ft_atoi(value);
+	else if (ft_strncmp(flag, "--size", 7) == 0)
+		sim->size = ft_atol(value);
+	else if (ft_strncmp(flag, "--seed", 7) == 0)
+		sim->seed = ft_atol(value);
+	else if (ft_strncmp(flag, "--rto", 6) == 0)
+		sim->rto_ns = ft_atol(value);
+	else
+		return (parse_link(&sim->link, flag, value));
+	return (1);
+}
+
+/**
+ * @brief Sets the default options of the simulator.
+ *
+ * @param sim Options to fill.
+ */
+static void	sim_defaults(t_sim *sim)
+{
+	sim->mode = -1;
+	sim->window = SIM_WINDOW;
+	sim->rto_ns = -1;
+	sim->runs = SIM_RUNS;
+	sim->size = SIM_SIZE;
+	sim->seed = 1;
+	sim->link.delay_ns = SIM_DELAY_NS;
+}
+
+/**
+ * @brief Parses the options of the simulator.
+ *
+ * Usage: bench/simulate [--mode legacy|rt|payload] [--window n] [--runs n]
+ * [--size n] [--seed n] [--rto ns] [--delay ns] [--jitter ns] [--loss ppm]
+ * [--dup ppm] [--coalesce]
+ *
+ * By default every encoding is simulated over a perfect link of
+ * SIM_DELAY_NS, with the retransmission timeout of the real client. On
+ * error the usage line is printed.
+ *
+ * @return 1 if the command line is valid, 0 otherwise.
+ */
+int	parse_simulate(int argc, char **argv, t_sim *sim)
+{
+	int	i;
+
+	sim_defaults(sim);
+	i = 1;
+	while (i < argc)
+	{
+		if (ft_strncmp(argv[i], "--coalesce", 11) == 0)
+			sim->link.coalesce = 1;
+		else if (i + 1 >= argc || !parse_option(sim, argv[i], argv[i + 1]))
+			break ;
+		else
+			i++;
+		i++;
+	}
+	if (i == argc && sim->window >= 1 && sim->window <= WINDOW_MAX
+		&& sim->runs > 0 && sim->seed != 0)
+		return (1);
+	ft_putendl_fd("Usage: bench/simulate [--mode legacy|rt|payload] "
+		"[--window n] [--runs n] [--size n] [--seed n] [--rto ns] "
+		"[--delay ns] [--jitter ns] [--loss ppm] [--dup ppm] [--coalesce]", 2);
+	return (0);
+}
@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:46:11 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Monotonic clock, in nanoseconds.
+ */
+long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Orders two samples for `qsort()`.
+ */
+static int	compare_samples(const void *a, const void *b)
+{
+	long	x;
+	long	y;
+
+	x = *(const long *)a;
+	y = *(const long *)b;
+	return ((x > y) - (x < y));
+}
+
+/**
+ * @brief Sorts `count` samples in place, in increasing order.
+ */
+void	samples_sort(long *samples, size_t count)
+{
+	qsort(samples, count, sizeof(long), compare_samples);
+}
+
+/**
+ * @brief Median of `count` run times (sorts them in place).
+ */
+long	median_ns(long *times, int count)
+{
+	samples_sort(times, count);
+	return (times[count / 2]);
+}
+
+/**
+ * @brief Adds the cost of one run to a sum of runs.
+ *
+ * A counter missing from one run (-1) is missing from the sum.
+ */
+void	cost_add(t_cost *sum, t_cost *cost)
+{
+	sum->nvcsw += cost->nvcsw;
+	sum->nivcsw += cost->nivcsw;
+	sum->minflt += cost->minflt;
+	sum->user_only |= cost->user_only;
+	if (sum->cycles < 0 || cost->cycles < 0)
+		sum->cycles = -1;
+	else
+		sum->cycles += cost->cycles;
+	if (sum->instructions < 0 || cost->instructions < 0)
+		sum->instructions = -1;
+	else
+		sum->instructions += cost->instructions;
+}
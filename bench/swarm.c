@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   swarm.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:49:02 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:52:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Builds the message of client `index`: "<index:" then its own
+ * letter up to `size` bytes, so that every message is distinct and can be
+ * found whole in the output of the server.
+ */
+static char	*swarm_message(int index, size_t size)
+{
+	char	*msg;
+	char	*tag;
+
+	msg = malloc(size + 1);
+	tag = ft_itoa(index);
+	if (!msg || !tag)
+		ft_error();
+	ft_memset(msg, 'a' + index % 26, size);
+	msg[size] = '\0';
+	msg[0] = '<';
+	ft_memcpy(msg + 1, tag, ft_strlen(tag));
+	msg[ft_strlen(tag) + 1] = ':';
+	free(tag);
+	return (msg);
+}
+
+/**
+ * @brief Starts all the clients of a step, as close together as possible.
+ *
+ * Messages are written to memfds beforehand, so that starting a client is
+ * only a `fork()`.
+ *
+ * @param swarm Step to start (`mode`, `count` and `size` are set; `size`
+ *              leaves room for the tag of the message).
+ * @param server PID of the server.
+ * @return 1 if every client was started, 0 otherwise.
+ */
+int	swarm_start(t_swarm *swarm, pid_t server)
+{
+	int	i;
+
+	i = 0;
+	while (i < swarm->count)
+	{
+		swarm->msgs[i] = swarm_message(i, swarm->size);
+		swarm->ins[i] = memfd_create("minitalk.bench", 0);
+		swarm->pids[i] = -1;
+		swarm->ok[i] = 0;
+		if (swarm->ins[i] < 0 || write(swarm->ins[i], swarm->msgs[i],
+				swarm->size) != (ssize_t)swarm->size)
+			return (0);
+		i++;
+	}
+	i = 0;
+	while (i < swarm->count)
+	{
+		swarm->start[i] = now_ns();
+		swarm->pids[i] = client_spawn(swarm->mode, server, swarm->msgs[i],
+				swarm->ins[i]);
+		if (swarm->pids[i] < 0)
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Collects the clients that have exited, or all of them.
+ *
+ * @param swarm Step of the clients.
+ * @param in_time 1 to collect the clients that have exited (before the
+ *                timeout), 0 to kill and collect the ones still running.
+ * @return Number of clients collected.
+ */
+static int	swarm_reap(t_swarm *swarm, int in_time)
+{
+	int	status;
+	int	reaped;
+	int	i;
+
+	reaped = 0;
+	i = 0;
+	while (i < swarm->count)
+	{
+		if (swarm->pids[i] > 0 && !in_time)
+			kill(swarm->pids[i], SIGKILL);
+		if (swarm->pids[i] > 0 && waitpid(swarm->pids[i], &status,
+				WNOHANG * in_time) == swarm->pids[i])
+		{
+			swarm->end[i] = now_ns();
+			swarm->ok[i] = (in_time && WIFEXITED(status)
+					&& WEXITSTATUS(status) == 0);
+			swarm->pids[i] = -1;
+			reaped++;
+		}
+		i++;
+	}
+	return (reaped);
+}
+
+/**
+ * @brief Waits for all the clients of a step, for at most BENCH_TIMEOUT_MS.
+ *
+ * SIGCHLD is blocked (see `main()`) and taken with `sigtimedwait()`, so
+ * clients are collected as soon as they exit; those still running at the
+ * timeout are killed and count as failed.
+ */
+void	swarm_wait(t_swarm *swarm)
+{
+	sigset_t		set;
+	struct timespec	left;
+	long			deadline;
+	int				running;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGCHLD);
+	deadline = now_ns() + BENCH_TIMEOUT_MS * 1000000L;
+	running = swarm->count - swarm_reap(swarm, 1);
+	while (running > 0 && now_ns() < deadline)
+	{
+		left.tv_sec = (deadline - now_ns()) / 1000000000L;
+		left.tv_nsec = (deadline - now_ns()) % 1000000000L;
+		if (sigtimedwait(&set, NULL, &left) == SIGCHLD)
+			running -= swarm_reap(swarm, 1);
+	}
+	if (running > 0)
+		swarm_reap(swarm, 0);
+}
+
+/**
+ * @brief Counts the messages found whole in the output of the server,
+ * then releases the messages and their memfds.
+ *
+ * A message broken up by another client's bytes, or by lost or extra
+ * bits, is not found.
+ *
+ * @param swarm Step of the clients.
+ * @param target Server that received the messages.
+ * @return Number of intact messages.
+ */
+int	swarm_finish(t_swarm *swarm, t_target *target)
+{
+	struct stat	st;
+	char		*buf;
+	ssize_t		len;
+	int			intact;
+	int			i;
+
+	buf = NULL;
+	len = 0;
+	if (fstat(target->out, &st) == 0 && st.st_size > target->header)
+		buf = ft_calloc(st.st_size - target->header + 1, 1);
+	if (buf)
+		len = pread(target->out, buf, st.st_size - target->header,
+				target->header);
+	intact = 0;
+	i = 0;
+	while (i < swarm->count)
+	{
+		intact += (len > 0 && ft_strnstr(buf, swarm->msgs[i], len) != NULL);
+		free(swarm->msgs[i]);
+		close(swarm->ins[i++]);
+	}
+	free(buf);
+	return (intact);
+}
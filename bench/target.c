@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   target.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:40:06 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:17:17 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Waits for the server to print its PID line.
+ *
+ * Servers print their PID once their signal handling is set up, so the
+ * end of that line is where messages start in the output file.
+ *
+ * @param target Server being started (`header` is set).
+ * @return 1 once the line is printed, 0 after BENCH_START_MS.
+ */
+static int	wait_header(t_target *target)
+{
+	char	buf[128];
+	ssize_t	len;
+	char	*end;
+	long	deadline;
+
+	deadline = now_ns() + BENCH_START_MS * 1000000L;
+	while (now_ns() < deadline)
+	{
+		len = pread(target->out, buf, sizeof(buf) - 1, 0);
+		if (len > 0)
+		{
+			buf[len] = '\0';
+			end = ft_strchr(buf, '\n');
+			if (end)
+			{
+				target->header = end + 1 - buf;
+				return (1);
+			}
+		}
+		usleep(1000);
+	}
+	return (0);
+}
+
+/**
+ * @brief Starts a server with its output redirected to `out_path`.
+ *
+ * As for a client (see `client_run()`), the child waits until its counters
+ * are open, so its cost is counted from its `execve()` on.
+ *
+ * @param target Server to fill.
+ * @param mode Mode under test (`server` is the program to run).
+ * @param out_path File that receives the output of the server.
+ * @return 1 once the server is ready, 0 otherwise.
+ */
+int	target_start(t_target *target, const t_mode *mode, char *out_path)
+{
+	char	*argv[2];
+	int		gate[2];
+	char	go;
+
+	target->out = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (target->out < 0 || pipe2(gate, O_CLOEXEC) < 0)
+		return (0);
+	target->pid = fork();
+	if (target->pid == 0 && close(gate[1]) == 0
+		&& read(gate[0], &go, 1) == 0 && dup2(target->out, 1) == 1)
+	{
+		argv[0] = (char *)mode->server;
+		argv[1] = NULL;
+		execv(argv[0], argv);
+	}
+	if (target->pid == 0)
+		_exit(127);
+	cost_open(&target->cost, target->pid, 1);
+	close(gate[0]);
+	close(gate[1]);
+	if (target->pid > 0 && wait_header(target))
+		return (1);
+	target_stop(target);
+	return (0);
+}
+
+/**
+ * @brief Reads how many signals a server has received so far.
+ *
+ * The count comes from the server's own metrics (see `stat_open()`), so
+ * it includes re-sent signals and leaves out the standard signals that
+ * were merged before the server read them.
+ *
+ * @param pid PID of the server.
+ * @return The count, or 0 for a server without metrics (`./server`).
+ */
+static unsigned long	target_signals(pid_t pid)
+{
+	t_metrics		*metrics;
+	unsigned long	signals;
+
+	metrics = stat_open(pid);
+	if (!metrics)
+		return (0);
+	signals = atomic_load(&metrics->signals);
+	munmap(metrics, sizeof(t_metrics));
+	return (signals);
+}
+
+/**
+ * @brief Stops a server, takes its cost and its signal count, and closes
+ * its output file.
+ */
+void	target_stop(t_target *target)
+{
+	struct rusage	usage;
+
+	target->signals = 0;
+	if (target->pid > 0)
+	{
+		target->signals = target_signals(target->pid);
+		kill(target->pid, SIGTERM);
+		if (wait4(target->pid, NULL, 0, &usage) == target->pid)
+			cost_usage(&target->cost, &usage);
+	}
+	cost_read(&target->cost);
+	cost_close(&target->cost);
+	target->pid = 0;
+	close(target->out);
+}
+
+/**
+ * @brief Checks that the server printed exactly the message sent to it.
+ *
+ * @param target Server that received the message.
+ * @param msg Message sent.
+ * @param size Length of the message.
+ * @return 1 if the output matches, 0 otherwise.
+ */
+int	target_check(t_target *target, const char *msg, size_t size)
+{
+	struct stat	st;
+	char		*buf;
+	ssize_t		len;
+	int			ok;
+
+	if (fstat(target->out, &st) < 0
+		|| (size_t)st.st_size != target->header + size)
+		return (0);
+	buf = malloc(size + 1);
+	if (!buf)
+		return (0);
+	len = pread(target->out, buf, size, target->header);
+	ok = (len == (ssize_t)size && ft_memcmp(buf, msg, size) == 0);
+	free(buf);
+	return (ok);
+}
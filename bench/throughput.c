@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   throughput.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:41:24 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:17:17 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench/bench.h"
+
+/**
+ * @brief Sends one message `bench->runs` times, to a new server each time.
+ *
+ * A new server per run keeps one broken run from spoiling the next ones.
+ * The measurement stops at the first run that fails (client error or
+ * timeout, or output different from the message), which is reported with
+ * `ok` 0 and no time. The cost of the client and of the server is added up
+ * over the runs, and so are the signals the server received.
+ *
+ * @param bench Benchmark options (the message is already in `bench->in`).
+ * @param mode Mode under test.
+ * @param res Measurement to fill (`size` is already set).
+ * @param msg Message to send.
+ */
+static void	measure(t_bench *bench, const t_mode *mode, t_result *res,
+		const char *msg)
+{
+	t_target	target;
+	long		times[BENCH_RUNS_MAX];
+
+	res->runs = 0;
+	res->ok = 1;
+	res->signals = 0;
+	ft_bzero(&res->client, sizeof(t_cost));
+	ft_bzero(&res->server, sizeof(t_cost));
+	while (res->runs < bench->runs && res->ok)
+	{
+		res->ok = target_start(&target, mode, bench->out_path);
+		if (!res->ok)
+			break ;
+		times[res->runs] = client_run(mode, &target, msg, bench->in);
+		res->ok = (times[res->runs] >= 0
+				&& target_check(&target, msg, res->size));
+		target_stop(&target);
+		cost_add(&res->client, &target.client);
+		cost_add(&res->server, &target.cost);
+		res->signals += target.signals;
+		res->runs++;
+	}
+	res->wall_ns = 0;
+	if (res->ok)
+		res->wall_ns = median_ns(times, res->runs);
+}
+
+/**
+ * @brief Measures one mode over the whole corpus, up to its size limit.
+ *
+ * Each measurement is written to standard output as CSV, and to the JSON
+ * report if there is one.
+ */
+static void	run_mode(t_bench *bench, const t_mode *mode)
+{
+	t_result	res;
+	char		*msg;
+	int			kind;
+
+	res.mode = mode->name;
+	res.size = 1;
+	while (res.size <= mode->max_size && res.size <= bench->max_size)
+	{
+		kind = 0;
+		while (kind < CORPUS_KINDS)
+		{
+			res.corpus = corpus_name(kind);
+			msg = corpus_fill(kind++, res.size);
+			if (!msg || ftruncate(bench->in, 0) < 0
+				|| pwrite(bench->in, msg, res.size, 0) != (ssize_t)res.size)
+				ft_error();
+			measure(bench, mode, &res, msg);
+			free(msg);
+			report_row(1, &res, 0, 0);
+			if (bench->json >= 0)
+				report_row(bench->json, &res, 1, bench->first);
+			bench->first = 0;
+		}
+		res.size *= 16;
+	}
+}
+
+/**
+ * @brief Parses the options of the benchmark.
+ *
+ * Usage: bench/throughput [--runs n] [--mode name] [--max-size n]
+ * [--json file]
+ *
+ * By default every mode is run 3 times on the whole corpus, without JSON
+ * report.
+ *
+ * @return 1 if the command line is valid, 0 otherwise.
+ */
+static int	parse_bench(int argc, char **argv, t_bench *bench)
+{
+	int	i;
+
+	bench->runs = 3;
+	bench->first = 1;
+	bench->max_size = BENCH_MAX_SIZE;
+	i = 1;
+	while (i + 1 < argc)
+	{
+		if (ft_strncmp(argv[i], "--runs", 7) == 0)
+			bench->runs = ft_atoi(argv[i + 1]);
+		else if (ft_strncmp(argv[i], "--mode", 7) == 0)
+			bench->only = argv[i + 1];
+		else if (ft_strncmp(argv[i], "--max-size", 11) == 0)
+			bench->max_size = ft_atol(argv[i + 1]);
+		else if (ft_strncmp(argv[i], "--json", 7) == 0)
+			bench->json_path = argv[i + 1];
+		else
+			return (0);
+		i += 2;
+	}
+	return (i == argc && bench->runs > 0 && bench->runs <= BENCH_RUNS_MAX
+		&& bench->max_size > 0);
+}
+
+/**
+ * @brief Opens the JSON report and the scratch files of the benchmark.
+ *
+ * Scratch files are named after the PID of the benchmark in /tmp. Failing
+ * to create a file is reported with `ft_error()`.
+ */
+static void	open_files(t_bench *bench)
+{
+	char	*pid;
+
+	pid = ft_itoa(getpid());
+	bench->in_path = ft_strjoin("/tmp/minitalk.bench.in.", pid);
+	bench->out_path = ft_strjoin("/tmp/minitalk.bench.out.", pid);
+	free(pid);
+	if (!bench->in_path || !bench->out_path)
+		ft_error();
+	bench->in = open(bench->in_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	bench->json = -1;
+	if (bench->json_path)
+		bench->json = open(bench->json_path,
+				O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (bench->in < 0 || (bench->json_path && bench->json < 0))
+		ft_error();
+}
+
+/**
+ * @brief End-to-end throughput benchmark (`make bench`).
+ *
+ * Starts the server of each mode, sends it every message of the corpus
+ * with the matching client and reports wall time, bytes/s, signals/s and
+ * signals per byte, as CSV on standard output and optionally as JSON.
+ */
+int	main(int argc, char **argv)
+{
+	t_bench	bench;
+	int		i;
+
+	ft_bzero(&bench, sizeof(t_bench));
+	if (!parse_bench(argc, argv, &bench))
+	{
+		ft_putendl_fd("Usage: bench/throughput [--runs n] [--mode name] "
+			"[--max-size n] [--json file]", 2);
+		return (1);
+	}
+	open_files(&bench);
+	report_edge(1, 0, 1);
+	report_edge(bench.json, 1, 1);
+	i = 0;
+	while (i < BENCH_MODES)
+	{
+		if (!bench.only || ft_strncmp(mode_get(i)->name, bench.only,
+				ft_strlen(bench.only) + 1) == 0)
+			run_mode(&bench, mode_get(i));
+		i++;
+	}
+	report_edge(bench.json, 1, 0);
+	unlink(bench.in_path);
+	unlink(bench.out_path);
+	return (0);
+}
@@ -6,41 +6,19 @@
 /*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/10/15 17:00:00 by maria-ol          #+#    #+#             */
-/*   Updated: 2025/10/16 22:48:19 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 21:50:03 by maria-ol         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "includes/minitalk_bonus.h"
 
-/**
- * @brief Global variable to indicate bit acknowledgment.
- *
- * Used by the client to synchronize communication — set to 1
- * whenever the server confirms that a bit was successfully received.
- */
-volatile sig_atomic_t	g_received = 0;
-
-/**
- * @brief Handles acknowledgment signals (SIGUSR2) from the server.
- *
- * When the client sends one bit, the server replies with SIGUSR2 to indicate
- * it has successfully received that bit. This function simply sets the
- * `g_received` flag to 1, allowing the client to continue sending the next bit.
- *
- * @param sig Signal number (should be SIGUSR2).
- */
-static void	handle_received(int sig)
-{
-	if (sig == SIGUSR2)
-		g_received = 1;
-}
-
 /**
  * @brief Handles completion signal (SIGUSR1) sent by the server.
  *
  * When the full message has been received and processed by the server,
  * it sends a SIGUSR1 signal to the client. This handler prints a confirmation
- * message and terminates the program gracefully.
+ * message, followed by the transfer statistics with `--stats`, and
+ * terminates the program gracefully (writing the trace with `--trace`).
  *
  * @param sig Signal number (should be SIGUSR1).
  */
@@ -48,7 +26,10 @@ static void	handle_completion(int sig)
 {
 	if (sig == SIGUSR1)
 	{
+		trace_span(TRACE_HANDLER, 1);
 		ft_printf("\nMessage received by server!\n");
+		stats_report();
+		trace_span(TRACE_HANDLER, 0);
 		exit(0);
 	}
 }
@@ -61,106 +42,150 @@ static void	handle_completion(int sig)
  * - SIGUSR2 → Confirms that a bit sent was received by the server.
  * - SIGUSR1 → Indicates that the entire message has been received.
  *
- * Using `sigaction` allows the use of flags like `SA_RESTART` which ensures 
- * that system calls (like `pause()`) automatically resume if interrupted by a
- * signal.
-
- * After sending each bit, the client blocks on `pause()` until the corresponding
- * acknowledgment signal is handled here.
+ * SIGUSR1 gets a regular handler. SIGUSR2, SIG_PAYLOAD_ACK and SIG_HELLO
+ * are blocked instead: each answer is consumed synchronously by
+ * `send_symbol()`, `send_payload()` or `negotiate()`, so it can never arrive
+ * between checking a flag and going to sleep.
  */
 void	setup_signal_handlers(void)
 {
-	struct sigaction	sa_received;
 	struct sigaction	sa_completion;
+	sigset_t			acks;
 
-	sa_received.sa_handler = handle_received;
-	sigemptyset(&sa_received.sa_mask);
-	sa_received.sa_flags = SA_RESTART;
-	sigaction(SIGUSR2, &sa_received, NULL);
 	sa_completion.sa_handler = handle_completion;
 	sigemptyset(&sa_completion.sa_mask);
 	sa_completion.sa_flags = SA_RESTART;
 	sigaction(SIGUSR1, &sa_completion, NULL);
+	sigemptyset(&acks);
+	sigaddset(&acks, SIGUSR2);
+	if (alphabet_available())
+	{
+		sigaddset(&acks, SIG_PAYLOAD_ACK);
+		sigaddset(&acks, SIG_HELLO);
+	}
+	sigprocmask(SIG_BLOCK, &acks, NULL);
 }
 
 /**
- * @brief Sends one character to the server process, bit by bit.
+ * @brief Waits up to `ACK_TIMEOUT_NS` for the acknowledgment of a symbol.
  *
- * Each bit of the character is transmitted as a UNIX signal:
- * - SIGUSR1 for bit 0
- * - SIGUSR2 for bit 1
+ * @param signal Signal carrying the symbol.
+ * @param marker Marker of the symbol.
+ * @return -1 once it is acknowledged, 1 if it must be sent again, 0 to
+ * keep waiting (late acknowledgment, or real-time symbol).
+ */
+static int	wait_ack(int signal, int marker)
+{
+	static const struct timespec	timeout = {0, ACK_TIMEOUT_NS};
+	sigset_t						acks;
+	siginfo_t						info;
+
+	sigemptyset(&acks);
+	sigaddset(&acks, SIGUSR2);
+	if (sigtimedwait(&acks, &info, &timeout) == -1)
+		return (signal == SIGUSR1 || signal == SIGUSR2);
+	if (info.si_code == SI_QUEUE)
+		server_busy(info.si_value.sival_int);
+	if (info.si_code != SI_QUEUE || info.si_value.sival_int == marker)
+		return (-1);
+	return (0);
+}
+
+/**
+ * @brief Sends one symbol and waits for the server to acknowledge it.
  *
- * After sending each bit, the client waits (using `pause()`) until the server
- * confirms receipt by sending SIGUSR2, ensuring reliable sequential 
- * communication.
+ * SIGUSR1 and SIGUSR2 are not queued: when two clients send the same
+ * signal at the same moment the kernel merges them and one is lost. This
+ * happens when several clients start together, or when a client waiting in
+ * the admission queue of a `--fifo` server collides with the active one.
+ * If no acknowledgment arrives within `ACK_TIMEOUT_NS` the bit is sent again,
+ * with the same marker: the server acknowledges it again without decoding
+ * it twice, and ignores it while the client waits in its admission queue.
+ * An acknowledgment queued with another marker is a late one, for the
+ * previous symbol, and is skipped; one sent with `kill()` (legacy server)
+ * has no marker and is always taken. An answer queued with QUEUE_BUSY ends
+ * the client (see `server_busy()`).
+ * Real-time signals are queued and never merged, so they are sent once and
+ * the client just keeps waiting. Signals go through `queue_signal()`, which
+ * backs off instead of failing when the server's signal queue is full.
+ * With `--stats`, the time from the last send to the acknowledgment is
+ * recorded as a round-trip time and every resend as a retransmit; with
+ * `--trace`, the acknowledgment is traced.
  *
  * @param server_pid PID of the server process.
- * @param chr Character to be sent.
+ * @param signal Signal carrying the symbol (SIGUSR1/SIGUSR2 for one bit, a
+ * real-time signal of the alphabet for `ALPHABET_BITS` bits).
+ * @param marker Marker of the symbol (see `encoder_next()`).
  */
-void	send_char(pid_t server_pid, unsigned char chr)
+void	send_symbol(pid_t server_pid, int signal, int marker)
 {
-	int				i;
-	unsigned int	bit;
-	unsigned int	signal;
+	int		resend;
+	long	sent;
 
-	i = 0;
-	while (i < 8)
+	resend = 1;
+	sent = 0;
+	while (resend >= 0)
 	{
-		bit = (chr >> i) & 1;
-		if (bit == 1)
-			signal = SIGUSR2;
-		else
-			signal = SIGUSR1;
-		g_received = 0;
-		if (kill(server_pid, signal) == -1)
+		if (resend)
 		{
-			ft_error();
-			exit(1);
+			if (queue_signal(server_pid, signal, marker) == -1)
+				ft_error();
+			stats_count(0, 1, sent != 0);
+			sent = stats_clock();
 		}
-		while (g_received == 0)
-			pause();
-		i++;
+		resend = wait_ack(signal, marker);
 	}
+	trace_mark(TRACE_ACK, SIGUSR2, server_pid, marker);
+	stats_ack(sent);
 }
 
 /**
  * @brief Entry point of the client program.
  *
- * Usage: ./client_bonus <server_pid> <message>
+ * Usage: ./client_bonus [--legacy] [--rt] [--payload] [--pull] [--shm]
+ * [--pipe] [--stripes n] [--stats] [--trace] <server> <message>
  *
- * The client sends the provided string message to the given server PID.
- * After sending all characters (including the null terminator),
- * it waits indefinitely for a SIGUSR1 confirmation.
+ * The client sends the provided string message to the given server PID,
+ * or to one of its workers if it runs with `--workers` (see
+ * `directory_lookup()`).
+ * It first negotiates the protocol with `negotiate()`, then sends the
+ * message with the best transport both sides support (see
+ * `send_message()`), down to the 1-bit SIGUSR1/SIGUSR2 protocol also used
+ * with legacy servers.
+ * It then waits indefinitely for a SIGUSR1 confirmation.
+ *
+ * With `--agent` the client instead stays up and forwards what local
+ * producers write to a FIFO, given in place of the message (see
+ * `run_agent()`).
+ *
+ * With `--stats` the client also reports what the transfer cost once it
+ * is confirmed (see `stats_report()`), and with `--trace` it writes the
+ * timeline of its signals when it exits (see `trace_start()`).
  * 
  * @note The use of an infinite `while (1) pause();` at the end ensures 
  * the client remains idle, while still responsive to any pending signals.
  *
- * @param argc Argument count (should be 3).
- * @param argv Argument vector ([1] = server PID, [2] = message).
+ * @param argc Argument count (3, plus one per flag).
+ * @param argv Argument vector (flags, then server PID and message).
  * @return 0 on success, 1 on failure.
  */
 int	main(int argc, char **argv)
 {
-	pid_t	server_pid;
-	int		i;
+	t_options	opts;
 
-	if (argc != 3)
-		return (1);
-	server_pid = ft_atoi(argv[1]);
-	if (server_pid <= 0)
-	{
-		ft_error();
+	if (!parse_args(argc, argv, &opts))
 		return (1);
-	}
+	directory_lookup(&opts);
 	ft_printf("Client PID: %d\n", getpid());
 	setup_signal_handlers();
-	i = 0;
-	while (argv[2][i])
-	{
-		send_char(server_pid, (unsigned char)argv[2][i]);
-		i++;
-	}
-	send_char(server_pid, '\0');
+	if (opts.stats)
+		stats_start(opts.server_pid);
+	if (opts.trace)
+		trace_start("client");
+	if (opts.agent)
+		run_agent(&opts);
+	negotiate(&opts);
+	send_message(&opts);
 	while (1)
 		pause();
 	return (0);
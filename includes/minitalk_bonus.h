@@ -6,19 +6,958 @@
 /*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/10/13 13:41:54 by mona              #+#    #+#             */
-/*   Updated: 2025/10/16 20:35:58 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 22:14:28 by maria-ol         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef MINITALK_BONUS_H
 # define MINITALK_BONUS_H
 
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
 # include "libft/libft.h"
 # include <signal.h>
+# include <time.h>
+# include <errno.h>
+# include <sys/resource.h>
+# include <fcntl.h>
+# include <pthread.h>
+# include <sched.h>
+# include <semaphore.h>
+# include <stdatomic.h>
+# include <sys/prctl.h>
+# include <sys/uio.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+# include <sys/stat.h>
+# include <poll.h>
+# include <sys/signalfd.h>
+# include <malloc.h>
+# include <linux/perf_event.h>
 
-void	signal_handler(int sig, siginfo_t *info, void *context);
-void	setup_signals(void);
-void	send_char(pid_t server_pid, unsigned char chr);
+/**
+ * @brief Maximum number of clients waiting for their turn in FIFO mode.
+ *
+ * A client that finds the queue full is turned away: its signal is
+ * answered with the value QUEUE_BUSY (see `admit_client()`).
+ */
+# define QUEUE_SIZE 64
+# define QUEUE_BUSY -1
+
+/**
+ * @brief Maximum number of clients the server decodes concurrently.
+ */
+# define MAX_SESSIONS 128
+
+/**
+ * @brief Client exit tracking (see `serve()`).
+ *
+ * Up to WATCH_MAX client processes are watched with a pidfd at a time.
+ * Signals are read from the signalfd SIGNAL_BATCH at a time. A record
+ * with the pseudo-signal SIG_GONE tells the decoder that its client has
+ * exited (no real signal has number 0).
+ */
+# define WATCH_MAX 256
+# define SIGNAL_BATCH 64
+# define SIG_GONE 0
+
+/**
+ * @brief Time a client waits for an acknowledgment before re-sending (100 ms).
+ *
+ * Only SIGUSR1/SIGUSR2 bits are re-sent. Each symbol is queued with a
+ * marker, 1 or 2 in turn, which its acknowledgment carries back, so the
+ * server discards a repeated symbol and the client ignores a late
+ * acknowledgment (see `send_symbol()` and `session_feed()`).
+ */
+# define ACK_TIMEOUT_NS 100000000
+
+/**
+ * @brief Bits carried by one signal of the real-time alphabet (`--rt`).
+ *
+ * The alphabet uses 2^ALPHABET_BITS signals from SIGRTMIN upwards. glibc
+ * leaves 31 real-time signals to applications, so 4 bits (16 signals) is
+ * the largest power of two that fits.
+ */
+# define ALPHABET_BITS 4
+# define ALPHABET_SIZE 16
+
+/**
+ * @brief Real-time signals of the payload mode (`--payload`).
+ *
+ * SIG_PAYLOAD is sent with `sigqueue()` and carries a frame packed by
+ * `payload_pack()`; the server answers each frame with SIG_PAYLOAD_ACK.
+ */
+# define SIG_PAYLOAD (SIGRTMIN + ALPHABET_SIZE)
+# define SIG_PAYLOAD_ACK (SIGRTMIN + ALPHABET_SIZE + 1)
+
+/**
+ * @brief Bytes carried by one payload frame (fits in `sival_int`).
+ */
+# define PAYLOAD_BYTES 3
+
+/**
+ * @brief Send window of the payload mode, sized from RLIMIT_SIGPENDING.
+ *
+ * Queued signals pending for all processes of a user are bounded by the
+ * receiver's RLIMIT_SIGPENDING. A client takes 1/WINDOW_SHARE of it, leaving
+ * room for other clients, within [1, WINDOW_MAX] frames in flight.
+ */
+# define WINDOW_SHARE 64
+# define WINDOW_MAX 256
+
+/**
+ * @brief Backoff bounds when `sigqueue()` fails with EAGAIN (50 us - 10 ms).
+ */
+# define BACKOFF_MIN_NS 50000
+# define BACKOFF_MAX_NS 10000000
+
+/**
+ * @brief Session handshake (protocol version 1).
+ *
+ * The client queues SIG_HELLO with `hello_pack(features, window)` and the
+ * server answers with SIG_HELLO carrying the features it accepted and the
+ * window it allows. A client that gets no answer within HELLO_TIMEOUT_NS
+ * falls back to the 1-bit SIGUSR1/SIGUSR2 protocol.
+ *
+ * Layout of `sival_int`: bits 0..7 features, bits 8..23 window, bits 24..30
+ * protocol version.
+ *
+ * FEAT_ALL is what a client requests by default. FEAT_KEEP is only
+ * requested by the agent (`--agent`): the server then keeps the session,
+ * and its features, from one message to the next until the client exits.
+ */
+# define SIG_HELLO (SIGRTMIN + ALPHABET_SIZE + 2)
+# define PROTO_VERSION 1
+# define HELLO_TIMEOUT_NS 500000000
+# define FEAT_ALPHABET 1
+# define FEAT_PAYLOAD 2
+# define FEAT_STRIPES 4
+# define FEAT_PULL 8
+# define FEAT_SHM 16
+# define FEAT_PIPE 32
+# define FEAT_ALL 63
+# define FEAT_KEEP 64
+
+/**
+ * @brief Kinds of payload frames (bits 26..29 of the frame).
+ *
+ * FRAME_DATA frames carry message bytes. The other kinds each carry a
+ * 24-bit field (see `payload_header()`) stored in the sender's session.
+ *
+ * Header of a stripe (`--stripes`), sent before its bytes:
+ * - FRAME_GROUP  → PID of the client that forked the workers
+ * - FRAME_STRIPE → stripe index (bits 0..7) and stripe count (bits 8..15)
+ * - FRAME_OFFSET → offset of the stripe in the message
+ * - FRAME_TOTAL  → length of the whole message
+ *
+ * Pull request (`--pull`), in this order:
+ * - FRAME_ADDR0..2 → address of the message, 24 bits at a time
+ * - FRAME_LEN0..1  → length of the message, 24 bits at a time
+ * - FRAME_PULL     → the server copies the message out of the client
+ *
+ * Shared-memory request (`--shm`):
+ * - FRAME_SHM → the server attaches to the client's ring (see t_shm_ring)
+ *
+ * Named pipe request (`--pipe`):
+ * - FRAME_PIPE → the server creates the pipe the client writes to
+ */
+# define FRAME_DATA 0
+# define FRAME_GROUP 1
+# define FRAME_STRIPE 2
+# define FRAME_OFFSET 3
+# define FRAME_TOTAL 4
+# define FRAME_ADDR0 5
+# define FRAME_ADDR1 6
+# define FRAME_ADDR2 7
+# define FRAME_LEN0 8
+# define FRAME_LEN1 9
+# define FRAME_PULL 10
+# define FRAME_SHM 11
+# define FRAME_PIPE 12
+
+/**
+ * @brief Size limits of pull transfers (`--pull`).
+ *
+ * Shorter messages are cheaper to send in payload frames than to set up a
+ * pull; longer ones are refused by the server, which would have to
+ * allocate them at once.
+ */
+# define PULL_MIN_SIZE 64
+# define PULL_MAX_SIZE 0x40000000
+
+/**
+ * @brief Number of client transports (see `send_message()`).
+ */
+# define TRANSPORT_COUNT 6
+
+/**
+ * @brief Shared-memory transport (`--shm`).
+ *
+ * The client creates SHM_PREFIX<client pid> with `shm_open()`, holding a
+ * ring of SHM_RING_SIZE bytes. Both sides spin SHM_SPIN times on the ring
+ * before sleeping on a futex, and re-check the other side every
+ * SHM_WAIT_NS while asleep. Messages shorter than SHM_MIN_SIZE bytes are
+ * sent in frames.
+ */
+# define SHM_PREFIX "/minitalk."
+# define SHM_RING_SIZE 1048576
+# define SHM_MIN_SIZE 64
+# define SHM_SPIN 2000
+# define SHM_WAIT_NS 100000000
+
+/**
+ * @brief Named pipe transport (`--pipe`).
+ *
+ * The server creates DIRECTORY_PREFIX<server pid>.pipes/<client pid> with
+ * `mkfifo()`, in a directory only its user can open, and grows its buffer
+ * to PIPE_SIZE bytes. The acknowledgment of FRAME_PIPE carries
+ * PIPE_ACCEPTED once the pipe is ready; any other value is a refusal.
+ * Until the client opens it, the server checks every PIPE_WAIT_MS that the
+ * client still exists. Messages shorter than PIPE_MIN_SIZE bytes are sent
+ * in frames. The server gathers each message in a memfd named PIPE_NAME
+ * before writing it.
+ */
+# define PIPE_NAME "minitalk.pipe"
+# define PIPE_SIZE 1048576
+# define PIPE_MIN_SIZE 64
+# define PIPE_WAIT_MS 100
+# define PIPE_ACCEPTED 1
+
+/**
+ * @brief Limits of striped transfers (`--stripes`).
+ *
+ * Offsets and lengths travel in 24-bit header fields, so a striped message
+ * is at most STRIPE_MAX_SIZE bytes; longer ones are sent by a single
+ * process. The server reassembles up to MAX_GROUPS messages at a time.
+ */
+# define STRIPES_MAX 16
+# define STRIPE_MAX_SIZE 0xFFFFFF
+# define MAX_GROUPS 16
+
+/**
+ * @brief Client agent (`--agent`).
+ *
+ * Bytes written by producers are sent in batches of up to AGENT_BATCH
+ * bytes, at most AGENT_DELAY_MS after the first byte of the batch.
+ */
+# define AGENT_BATCH 65536
+# define AGENT_DELAY_MS 5
+
+/**
+ * @brief Warm-up of the server (`--prewarm`).
+ *
+ * PREWARM_HEAP bytes of heap and PREWARM_STACK bytes of stack are faulted
+ * in before the server prints its PID.
+ */
+# define PREWARM_HEAP 16777216
+# define PREWARM_STACK 262144
+
+/**
+ * @brief Server metrics (see `metrics_start()` and `minitalk_stat`).
+ *
+ * Each server process keeps its counters in a memfd named METRICS_NAME,
+ * which `minitalk_stat` maps read-only through /proc/<pid>/fd. Up to
+ * METRICS_CLIENTS clients get a row of their own. A serialized gap
+ * histogram (`minitalk_stat --save`) takes at most 3 + 30 + 13 bytes per
+ * bucket, which METRICS_HIST_SIZE covers.
+ */
+# define METRICS_NAME "minitalk.stats"
+# define METRICS_CLIENTS 128
+# define METRICS_HIST_SIZE 4096
+
+/**
+ * @brief Signal timeline tracing (`--trace`, see `trace_start()`).
+ *
+ * Each process records up to TRACE_EVENTS events in a buffer mapped once,
+ * then writes them as Chrome trace JSON to
+ * DIRECTORY_PREFIX<pid>TRACE_SUFFIX when it exits; later events are only
+ * counted. Kinds of events:
+ * - TRACE_SEND    → the client sent a signal
+ * - TRACE_DELIVER → the server read a signal from its signalfd
+ * - TRACE_HANDLER → a signal is being handled (begin and end)
+ * - TRACE_ACK     → the server sent an acknowledgment, or the client got it
+ * - TRACE_WRITE   → a message is being written out (begin and end)
+ */
+# define TRACE_EVENTS 262144
+# define TRACE_SUFFIX ".trace.json"
+# define TRACE_SEND 0
+# define TRACE_DELIVER 1
+# define TRACE_HANDLER 2
+# define TRACE_ACK 3
+# define TRACE_WRITE 4
+
+/**
+ * @brief Signal log (`--record path`, see `record_start()`).
+ *
+ * The log starts with the RECORD_MAGIC bytes and the flags of the server
+ * (RECORD_FIFO in `--fifo` mode), so that a replay runs the same
+ * admission as the server did. Each record then holds the
+ * nanoseconds elapsed since the previous one (since the log was started,
+ * for the first), the sender PID, the signal number and the queued value,
+ * all as LEB128 numbers (see `ft_put_varint()`), so most records take 6 to
+ * 9 bytes instead of the 128 of a signalfd_siginfo. Records are buffered
+ * RECORD_BUFFER bytes at a time. SIG_GONE records are logged too, so a
+ * replay releases sessions where the server did.
+ */
+# define RECORD_MAGIC "MTLOG2\n"
+# define RECORD_MAGIC_LEN 7
+# define RECORD_FIFO 1
+# define RECORD_BUFFER 65536
+
+/**
+ * @brief Threaded server (`--threads n`).
+ *
+ * Up to THREADS_MAX decoder threads; each one receives records through a
+ * ring of RING_SIZE slots and hands complete messages to the writer thread
+ * through another one.
+ */
+# define THREADS_MAX 16
+# define RING_SIZE 4096
+
+/**
+ * @brief Worker pool (`--workers n`).
+ *
+ * The master publishes the PIDs of its workers, one per line, in
+ * DIRECTORY_PREFIX<master pid>.workers, where clients look them up.
+ */
+# define WORKERS_MAX 64
+# define DIRECTORY_PREFIX "/tmp/minitalk."
+
+/**
+ * @brief Results of `session_feed()`.
+ *
+ * - FEED_DROP → the signal was not understood, nothing to acknowledge
+ * - FEED_ACK  → the symbol was decoded and must be acknowledged
+ * - FEED_DONE → the message is complete
+ * - FEED_PULL → the message must be copied out of the client
+ * - FEED_SHM  → the client asks the server to attach to its ring
+ * - FEED_PIPE → the client asks the server for a named pipe
+ * - FEED_ACCEPT → the named pipe is ready: acknowledged with PIPE_ACCEPTED
+ * - FEED_BUSY → not a decoder result: the FIFO admission queue is full
+ *   and the sender is answered with QUEUE_BUSY (see `handle_record()`)
+ */
+# define FEED_DROP 0
+# define FEED_ACK 1
+# define FEED_DONE 2
+# define FEED_PULL 3
+# define FEED_SHM 4
+# define FEED_PIPE 5
+# define FEED_ACCEPT 6
+# define FEED_BUSY 7
+
+/**
+ * @brief Encodings of a message in signals (see `encoder_next()`).
+ *
+ * - ENCODE_BITS     → SIGUSR1/SIGUSR2, one bit per signal
+ * - ENCODE_ALPHABET → real-time alphabet, ALPHABET_BITS bits per signal
+ * - ENCODE_FRAMES   → SIG_PAYLOAD frames of PAYLOAD_BYTES bytes
+ */
+# define ENCODE_BITS 0
+# define ENCODE_ALPHABET 1
+# define ENCODE_FRAMES 2
+
+/**
+ * @brief One received signal: sender, signal number and queued value.
+ */
+typedef struct s_record
+{
+	pid_t	pid;
+	int		sig;
+	int		value;
+}	t_record;
+
+/**
+ * @brief Send side of the protocols: the signals of one message, in order.
+ *
+ * `pos` is the next byte of `message` to encode and `bit` the next bit of
+ * that byte (symbol encodings). The message ends with a '\0' character
+ * or an empty frame; `last` is set once that terminator has been produced.
+ * Nothing is sent here: the caller sends, waits and retransmits, so the
+ * same encoder drives the client and `bench/simulate`. `marker` is the
+ * marker of the last symbol produced (see `encoder_next()`).
+ */
+typedef struct s_encoder
+{
+	const char	*message;
+	size_t		len;
+	size_t		pos;
+	int			bit;
+	int			mode;
+	int			last;
+	int			marker;
+}	t_encoder;
+
+/**
+ * @brief Descriptors of the server event loop.
+ *
+ * `fds[0]` is the signalfd of the client signals; `fds[i]` (i >= 1) is a
+ * pidfd of the client `pids[i]`, readable once the client has exited.
+ */
+typedef struct s_watch
+{
+	struct pollfd	fds[WATCH_MAX + 1];
+	pid_t			pids[WATCH_MAX + 1];
+	int				count;
+}	t_watch;
+
+/**
+ * @brief Bounded ring buffer of waiting clients (oldest at `head`).
+ *
+ * Each slot keeps the record of the client's first signal, decoded once
+ * the client is admitted.
+ */
+typedef struct s_queue
+{
+	t_record	slots[QUEUE_SIZE];
+	int			head;
+	int			count;
+}	t_queue;
+
+/**
+ * @brief Stripe header received from a worker of a striped transfer.
+ *
+ * `count` is 0 for a regular (unstriped) message.
+ */
+typedef struct s_stripe
+{
+	pid_t	group;
+	int		index;
+	int		count;
+	size_t	offset;
+	size_t	total;
+}	t_stripe;
+
+/**
+ * @brief Decoding state of one client, identified by its PID.
+ *
+ * `current` and `bit_count` accumulate the character being received, and
+ * `buf` holds the message until it is complete, so that messages from
+ * concurrent clients are never interleaved on the output. `marker` is the
+ * marker of the last symbol decoded (see `session_feed()`).
+ */
+typedef struct s_session
+{
+	pid_t			pid;
+	int				features;
+	int				marker;
+	int				bit_count;
+	unsigned char	current;
+	char			*buf;
+	size_t			len;
+	size_t			cap;
+	t_stripe		stripe;
+	unsigned long	pull_addr;
+	size_t			pull_len;
+}	t_session;
+
+/**
+ * @brief Complete message (or stripe) waiting to be written.
+ *
+ * `buf` is owned by the chunk and released by `output_chunk()`, which
+ * also sends the completion to `pid` (0 when nobody is waiting for it).
+ * A `release` chunk carries no message: it tells the writer that `pid` has
+ * exited, so the stripe groups it owns are dropped (see `stripe_release()`).
+ */
+typedef struct s_chunk
+{
+	char		*buf;
+	size_t		len;
+	t_stripe	stripe;
+	pid_t		pid;
+	int			release;
+}	t_chunk;
+
+/**
+ * @brief Message being reassembled from the stripes of several workers.
+ *
+ * `id` is the PID of the client that forked the workers; bit n of
+ * `received` is set once stripe n has been copied into `buf`.
+ */
+typedef struct s_group
+{
+	pid_t			id;
+	int				count;
+	unsigned int	received;
+	size_t			total;
+	char			*buf;
+}	t_group;
+
+/**
+ * @brief Server state: sessions, FIFO admission and negotiated limits.
+ *
+ * `fifo`, `threads` and `workers` are the command-line options. In threaded
+ * mode `pipeline` is set on the main server and `shard` on the server of
+ * each decoder thread, which only holds the sessions of its own PIDs.
+ * `record` is the path of the signal log (`--record`), or NULL.
+ */
+typedef struct s_server
+{
+	t_session			sessions[MAX_SESSIONS];
+	t_group				groups[MAX_GROUPS];
+	t_queue				queue;
+	pid_t				active;
+	int					fifo;
+	int					threads;
+	int					workers;
+	int					window;
+	int					ready_fd;
+	int					prewarm;
+	int					trace;
+	const char			*record;
+	char				*pidfile;
+	struct s_pipeline	*pipeline;
+	struct s_shard		*shard;
+}	t_server;
+
+/**
+ * @brief Single-producer single-consumer ring of records.
+ *
+ * The producer only writes `tail` and the consumer only writes `head`, so
+ * no lock is needed; `ready` counts the records to consume.
+ */
+typedef struct s_ring
+{
+	t_record	slots[RING_SIZE];
+	atomic_uint	head;
+	atomic_uint	tail;
+	sem_t		ready;
+}	t_ring;
+
+/**
+ * @brief Single-producer single-consumer ring of complete messages.
+ */
+typedef struct s_chunk_ring
+{
+	t_chunk		slots[RING_SIZE];
+	atomic_uint	head;
+	atomic_uint	tail;
+}	t_chunk_ring;
+
+/**
+ * @brief One decoder thread: its sessions and its two rings.
+ */
+typedef struct s_shard
+{
+	t_server			server;
+	t_ring				in;
+	t_chunk_ring		out;
+	pthread_t			thread;
+	struct s_pipeline	*pipeline;
+}	t_shard;
+
+/**
+ * @brief Threads of the threaded server.
+ *
+ * The main thread receives the signals, `count` decoder threads each own
+ * the clients whose PID modulo `count` is their index, and the writer
+ * thread prints complete messages. `output` counts the chunks waiting in
+ * all the output rings.
+ */
+typedef struct s_pipeline
+{
+	t_shard		*shards;
+	int			count;
+	sem_t		output;
+	pthread_t	writer;
+	t_server	*server;
+}	t_pipeline;
+
+/**
+ * @brief Worker servers forked by the master (`--workers n`).
+ */
+typedef struct s_workers
+{
+	pid_t	pids[WORKERS_MAX];
+	int		count;
+	char	*path;
+}	t_workers;
+
+/**
+ * @brief Single-producer single-consumer byte ring in shared memory.
+ *
+ * The client writes at `tail`, the server reads at `head`. The server
+ * sleeps on `seq`, which the client bumps after publishing bytes or
+ * setting `closed`; the client sleeps on `head` when the ring is full.
+ * `server_asleep` and `client_asleep` are set while that side sleeps, so
+ * the other side only makes the wake-up system call when it is needed.
+ * `attached` is set by the server before it acknowledges FRAME_SHM, and
+ * `aborted` when it gives up on the message.
+ */
+typedef struct s_shm_ring
+{
+	atomic_uint	head;
+	atomic_uint	tail;
+	atomic_uint	seq;
+	atomic_uint	server_asleep;
+	atomic_uint	client_asleep;
+	atomic_uint	attached;
+	atomic_uint	closed;
+	atomic_uint	aborted;
+	char		data[SHM_RING_SIZE];
+}	t_shm_ring;
+
+/**
+ * @brief Server side of a shared-memory transfer, drained by its own thread.
+ *
+ * `head` is the server's own copy of the read position: the client can
+ * write anything to the ring, so the shared `head` is only published for
+ * it and never read back.
+ */
+typedef struct s_shm_session
+{
+	pid_t			pid;
+	t_shm_ring		*ring;
+	unsigned int	head;
+	t_session		msg;
+}	t_shm_session;
+
+/**
+ * @brief Server side of a named pipe transfer, read by its own thread.
+ */
+typedef struct s_pipe_session
+{
+	pid_t	pid;
+	int		fd;
+	char	*path;
+}	t_pipe_session;
+
+/**
+ * @brief Metrics of one client of the server.
+ *
+ * A row is taken on the client's first signal and freed when it exits
+ * (`pid` is 0 for a free row). `last_ns` is the time of its last signal
+ * and `gaps` the histogram of the gaps between its signals, in ns.
+ */
+typedef struct s_client_metrics
+{
+	atomic_int		pid;
+	atomic_ulong	signals;
+	atomic_ulong	bytes;
+	atomic_ulong	messages;
+	long			last_ns;
+	t_hist			gaps;
+}	t_client_metrics;
+
+/**
+ * @brief Server metrics, shared read-only with `minitalk_stat`.
+ *
+ * Counters only grow, except `active` (clients holding a row). `drops`
+ * counts signals the decoder refused, which the client has to send again,
+ * and `aborts` messages left unfinished by a client that exited; both
+ * mean the client and the server had to resynchronize. Times come from
+ * CLOCK_MONOTONIC.
+ */
+typedef struct s_metrics
+{
+	pid_t				pid;
+	long				start_ns;
+	long				last_ns;
+	atomic_ulong		signals;
+	atomic_ulong		bytes;
+	atomic_ulong		messages;
+	atomic_ulong		drops;
+	atomic_ulong		aborts;
+	atomic_uint			active;
+	t_hist				gaps;
+	t_client_metrics	clients[METRICS_CLIENTS];
+}	t_metrics;
+
+/**
+ * @brief One traced event.
+ *
+ * `phase` is the Chrome trace phase: 'i' for an instant event, 'B' and 'E'
+ * for the begin and end of a span. `sig`, `peer` and `value` describe the
+ * signal of an instant event (`peer` is the other process).
+ */
+typedef struct s_trace_event
+{
+	long	ts_ns;
+	pid_t	tid;
+	short	kind;
+	char	phase;
+	int		sig;
+	pid_t	peer;
+	int		value;
+}	t_trace_event;
+
+/**
+ * @brief Trace of this process (see `trace_start()`).
+ *
+ * `count` keeps growing past TRACE_EVENTS, so the dump tells how many
+ * events were lost. `path` is built in advance, as the trace may be
+ * written from a signal handler.
+ */
+typedef struct s_trace
+{
+	t_trace_event	*events;
+	atomic_uint		count;
+	atomic_int		dumped;
+	pid_t			pid;
+	const char		*name;
+	char			*path;
+}	t_trace;
+
+/**
+ * @brief Signal log of this process (see `record_start()`).
+ *
+ * `fd` is only valid while `on` is set; `last_ns` is the time of the last
+ * logged record and `len` the bytes of `buf` not written yet.
+ */
+typedef struct s_recorder
+{
+	int				on;
+	int				fd;
+	long			last_ns;
+	size_t			len;
+	unsigned char	buf[RECORD_BUFFER];
+}	t_recorder;
+
+/**
+ * @brief Signal log being replayed (see `replay_open()`).
+ *
+ * The log is mapped whole, so reading it costs no system call during the
+ * replay. `at_ns` is the recorded time of the last record read, relative to
+ * the start of the log. The counters are reported by `minitalk_replay`:
+ * `out_of_band` counts the messages whose bytes did not travel in signals
+ * (pull, shared memory or named pipe), which a log cannot replay. `fifo`
+ * is set if the log was recorded in `--fifo` mode.
+ */
+typedef struct s_replay
+{
+	const unsigned char	*data;
+	size_t				len;
+	size_t				pos;
+	int					fifo;
+	long				at_ns;
+	unsigned long		signals;
+	unsigned long		messages;
+	unsigned long		bytes;
+	unsigned long		out_of_band;
+}	t_replay;
+
+/**
+ * @brief Client command-line options and negotiated session parameters.
+ *
+ * `features` holds the FEAT_* flags requested on the command line, then the
+ * ones accepted by the server after `negotiate()`. `frames` and `acked`
+ * count the payload frames sent and acknowledged so far, and `sent_ns`
+ * holds the send time of the frames in flight when `--stats` is given.
+ * `answer` is the value queued with the last acknowledgment received.
+ * `agent` is set by `--agent`, and `wanted` holds the features the agent
+ * requests each time it negotiates (see `run_agent()`).
+ */
+typedef struct s_options
+{
+	int		features;
+	int		wanted;
+	int		agent;
+	int		legacy;
+	int		window;
+	int		stripes;
+	int		frames;
+	int		acked;
+	int		answer;
+	int		stats;
+	int		trace;
+	pid_t	server_pid;
+	char	*message;
+	long	sent_ns[WINDOW_MAX];
+}	t_options;
+
+/**
+ * @brief Kernel-side cost of a process (see `cost_open()`).
+ *
+ * `pid` is the process measured, 0 for this one and the children it has
+ * waited for. Context switches (voluntary, when it sleeps, and involuntary,
+ * when it is preempted) and minor page faults come from `getrusage()`,
+ * `wait4()` or /proc. Cycles and instructions come from the `perf` counters
+ * `perf[0]` and `perf[1]`; they are -1 when `perf_event_open()` is not
+ * permitted, and `user_only` is set when only user space may be counted.
+ */
+typedef struct s_cost
+{
+	pid_t	pid;
+	int		user_only;
+	int		perf[2];
+	long	nvcsw;
+	long	nivcsw;
+	long	minflt;
+	long	cycles;
+	long	instructions;
+}	t_cost;
+
+/**
+ * @brief Client transfer statistics, shared with the stripe workers.
+ *
+ * Counters are updated atomically by every process of the client. `rtt`
+ * holds the round-trip times in nanoseconds, from sending a signal to its
+ * acknowledgment, in constant memory however long the message. `client`
+ * and `server` hold the cost of both processes when statistics started.
+ */
+typedef struct s_stats
+{
+	atomic_ulong	bytes;
+	atomic_ulong	signals;
+	atomic_ulong	retransmits;
+	long			start_ns;
+	t_hist			rtt;
+	t_cost			client;
+	t_cost			server;
+}	t_stats;
+
+/**
+ * @brief One way of sending a message (see `send_message()`).
+ *
+ * `send` returns 1 once the message is handed over (completion is then
+ * signalled with SIGUSR1), or 0 if the transport could not be used.
+ */
+typedef struct s_transport
+{
+	const char	*name;
+	int			feature;
+	size_t		min_size;
+	size_t		max_size;
+	int			(*send)(t_options *opts);
+}	t_transport;
+
+void	handle_record(t_server *server, t_record *rec);
+void	client_gone(t_server *server, pid_t pid);
+void	serve(t_server *server, sigset_t *set);
+void	setup_signals(sigset_t *set);
+void	send_symbol(pid_t server_pid, int signal, int marker);
 void	setup_signal_handlers(void);
+int		parse_args(int argc, char **argv, t_options *opts);
+char	*read_message(t_options *opts, char *arg);
+
+int		symbol_signal(int symbol);
+int		signal_symbol(int sig, int *value);
+int		alphabet_available(void);
+void	alphabet_mask(sigset_t *set);
+
+long	raise_sigpending(void);
+int		window_size(long limit);
+int		queue_signal(pid_t pid, int sig, int value);
+
+int		payload_pack(const char *bytes, int count);
+int		payload_unpack(int value, char *bytes);
+int		payload_header(int kind, size_t field);
+int		payload_kind(int value);
+int		wait_payload_ack(t_options *opts, int block);
+void	send_window(t_options *opts, int value);
+void	send_range(t_options *opts, size_t offset, size_t len);
+int		send_payload(t_options *opts);
+int		send_stripes(t_options *opts);
+int		send_pull(t_options *opts);
+void	send_message(t_options *opts);
+void	server_busy(int answer);
+void	run_agent(t_options *opts);
+void	stats_start(pid_t server);
+long	stats_clock(void);
+void	stats_count(size_t bytes, int signals, int retransmits);
+void	stats_ack(long sent_ns);
+void	stats_report(void);
+void	stats_print(t_stats *stats, long now_ns);
+void	cost_open(t_cost *cost, pid_t pid, int on_exec);
+void	cost_read(t_cost *cost);
+void	cost_usage(t_cost *cost, struct rusage *usage);
+void	cost_close(t_cost *cost);
+void	cost_sample(t_cost *cost);
+int		session_pull(t_session *session);
+
+t_shm_ring	*shm_map(pid_t client, int create);
+void		shm_unlink_ring(pid_t client);
+int			shm_wait(atomic_uint *word, unsigned int value,
+				atomic_uint *asleep);
+void		shm_wake(atomic_uint *word, atomic_uint *asleep);
+int			send_shm(t_options *opts);
+int			shm_start(t_server *server, t_session *session);
+char	*pipe_path(pid_t server, pid_t client);
+int		send_pipe(t_options *opts);
+int		pipe_start(t_server *server, t_session *session);
+ssize_t	output_splice(int fd);
+int		stripe_finish(t_server *server, t_chunk *chunk);
+void	stripe_release(t_server *server, pid_t pid);
+void	output_write(const char *buf, size_t len);
+void	output_chunk(t_server *server, t_chunk *chunk);
+
+int		ring_push(t_ring *ring, t_record *rec);
+int		ring_pop(t_ring *ring, t_record *out);
+int		chunk_push(t_chunk_ring *ring, t_chunk *chunk);
+int		chunk_pop(t_chunk_ring *ring, t_chunk *out);
+int		pipeline_start(t_server *server, int count);
+void	pipeline_route(t_pipeline *pipeline, t_record *rec);
+void	pipeline_emit(t_server *server, t_chunk *chunk);
+
+char	*pid_path(const char *prefix, pid_t pid, const char *suffix);
+int		directory_publish(const char *path, pid_t *pids, int count);
+int		directory_read(pid_t master, pid_t *pids);
+void	directory_lookup(t_options *opts);
+int		open_private(const char *path);
+int		create_private(const char *path);
+char	*name_path(const char *name);
+pid_t	server_lookup(const char *arg);
+void	parse_options(int argc, char **argv, t_server *server);
+void	server_publish(t_server *server);
+void	prewarm_bind(char **argv);
+void	prewarm(t_server *server);
+int		workers_start(t_server *server);
+
+int		queue_contains(t_queue *queue, pid_t pid);
+int		queue_push(t_queue *queue, t_record *rec);
+int		queue_pop(t_queue *queue, t_record *out);
+int		admit_client(t_queue *queue, pid_t *active, t_record *rec);
+int		next_client(t_queue *queue, pid_t *active, t_record *next);
+
+t_session	*session_get(t_server *server, pid_t pid);
+void		session_end(t_session *session);
+int			session_append(t_session *session, const char *bytes, size_t n);
+void		session_take(t_session *session, t_chunk *chunk);
+int			session_feed(t_session *session, int sig, int value);
+void		encoder_start(t_encoder *enc, const char *message, size_t len,
+				int mode);
+int			encoder_next(t_encoder *enc, t_record *out);
+
+void				metrics_start(void);
+t_metrics			*metrics_get(void);
+void				metrics_add(atomic_ulong *counter, unsigned long n);
+t_client_metrics	*metrics_row(pid_t pid);
+void				metrics_gone(pid_t pid);
+void				metrics_signal(pid_t pid);
+void				metrics_message(pid_t pid, size_t len);
+void				metrics_resync(int aborted);
+long				metrics_clock(void);
+t_metrics			*stat_open(pid_t pid);
+void				stat_print(t_metrics *metrics);
+void				stat_gaps(const char *title, t_hist *gaps);
+int					stat_pool(pid_t pid, t_hist *pool);
+int					stat_save(const char *path, t_hist *hist);
+int					stat_load(const char *path, t_hist *hist);
+void				stat_number(unsigned long n);
+
+void	trace_start(const char *name);
+t_trace	*trace_get(void);
+void	trace_mark(int kind, int sig, pid_t peer, int value);
+void	trace_span(int kind, int begin);
+void	trace_dump(void);
+void	dump_on_stop(void);
+
+int		record_start(t_server *server);
+char	*record_path(const char *path, pid_t pid);
+void	record_signal(t_record *rec);
+void	record_flush(void);
+int		replay_open(const char *path, t_replay *replay);
+int		replay_next(t_replay *replay, t_record *rec);
+void	replay_feed(t_server *server, t_replay *replay, t_record *rec);
+void	replay_turn(t_server *server, t_replay *replay);
+void	replay_leave(t_server *server, t_replay *replay, pid_t pid);
+
+int		hello_pack(int features, int window);
+int		hello_features(int value);
+int		hello_window(int value);
+void	answer_hello(t_server *server, t_record *rec);
+int		server_accepts(pid_t pid, int sig);
+void	negotiate(t_options *opts);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_hist.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:00:43 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:33:39 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Returns the bucket of a value.
+ *
+ * The bucket is the position of the leading bit of the value (its
+ * power-of-two range) followed by the next FT_HIST_SUB_BITS bits.
+ *
+ * @param value Value to place.
+ * @return Its bucket, from 0 to FT_HIST_BUCKETS - 1.
+ */
+int	ft_hist_index(unsigned long value)
+{
+	int	top;
+
+	if (value < (1UL << FT_HIST_SUB_BITS))
+		return ((int)value);
+	if (value >> FT_HIST_MAX_BITS)
+		return (FT_HIST_BUCKETS - 1);
+	top = FT_HIST_SUB_BITS;
+	while (value >> (top + 1))
+		top++;
+	return (((top - FT_HIST_SUB_BITS + 1) << FT_HIST_SUB_BITS)
+		+ (int)((value >> (top - FT_HIST_SUB_BITS))
+		& ((1UL << FT_HIST_SUB_BITS) - 1)));
+}
+
+/**
+ * @brief Returns the smallest value of a bucket.
+ *
+ * @param index Bucket, from 0 to FT_HIST_BUCKETS (the end of the last
+ * bucket).
+ * @return The smallest value placed in it.
+ */
+unsigned long	ft_hist_lower(int index)
+{
+	int	range;
+	int	sub;
+
+	if (index < (1 << FT_HIST_SUB_BITS))
+		return ((unsigned long)index);
+	range = index >> FT_HIST_SUB_BITS;
+	sub = index & ((1 << FT_HIST_SUB_BITS) - 1);
+	return (((1UL << FT_HIST_SUB_BITS) + sub) << (range - 1));
+}
+
+/**
+ * @brief Empties a histogram.
+ *
+ * Not to be called while it is being updated.
+ *
+ * @param hist Histogram to empty.
+ */
+void	ft_hist_reset(t_hist *hist)
+{
+	ft_bzero(hist, sizeof(t_hist));
+}
+
+/**
+ * @brief Raises an atomic value to at least `value`.
+ *
+ * @param word Value to raise.
+ * @param value Lower bound.
+ */
+static void	raise_to(atomic_ulong *word, unsigned long value)
+{
+	unsigned long	seen;
+
+	seen = atomic_load_explicit(word, memory_order_relaxed);
+	while (seen < value && !atomic_compare_exchange_weak_explicit(word,
+			&seen, value, memory_order_relaxed, memory_order_relaxed))
+		;
+}
+
+/**
+ * @brief Records one value.
+ *
+ * Only lock-free atomic operations are used, without allocation, so a
+ * value can be recorded from a signal handler, from several threads, or
+ * from several processes sharing the histogram, while it is read.
+ *
+ * @param hist Histogram to update.
+ * @param value Value to record.
+ */
+void	ft_hist_record(t_hist *hist, unsigned long value)
+{
+	atomic_fetch_add_explicit(&hist->buckets[ft_hist_index(value)], 1,
+		memory_order_relaxed);
+	atomic_fetch_add_explicit(&hist->sum, value, memory_order_relaxed);
+	raise_to(&hist->max, value);
+	raise_to(&hist->inv_min, ~value);
+	atomic_fetch_add_explicit(&hist->count, 1, memory_order_relaxed);
+}
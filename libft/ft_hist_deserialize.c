@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_hist_deserialize.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:01:53 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Adds the buckets of a serialized histogram to a histogram.
+ *
+ * @param hist Histogram receiving the buckets.
+ * @param buf Serialized histogram.
+ * @param len Length of `buf`.
+ * @param pos Position of the first bucket in `buf`.
+ * @return 1 on success, 0 if `buf` is malformed.
+ */
+static int	read_buckets(t_hist *hist, const unsigned char *buf, size_t len,
+		size_t pos)
+{
+	unsigned long	skip;
+	unsigned long	seen;
+	unsigned long	index;
+
+	index = 0;
+	while (pos < len)
+	{
+		if (!ft_get_varint(buf, len, &pos, &skip)
+			|| !ft_get_varint(buf, len, &pos, &seen)
+			|| skip >= FT_HIST_BUCKETS - index)
+			return (0);
+		index += skip;
+		atomic_fetch_add(&hist->buckets[index], seen);
+		atomic_fetch_add(&hist->count, seen);
+		index++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Adds a histogram written by `ft_hist_serialize()` to `hist`.
+ *
+ * Histograms written with other bucket parameters are refused, as is a
+ * truncated or corrupted buffer (`hist` may then hold part of it). As for
+ * `ft_hist_merge()`, `hist` must only be updated by the caller.
+ *
+ * @param hist Histogram receiving the values.
+ * @param buf Serialized histogram.
+ * @param len Length of `buf`.
+ * @return 1 on success, 0 if `buf` cannot be read.
+ */
+int	ft_hist_deserialize(t_hist *hist, const unsigned char *buf, size_t len)
+{
+	unsigned long	head[3];
+	size_t			pos;
+	unsigned long	count;
+
+	if (len < 3 || buf[0] != 'H' || buf[1] != FT_HIST_SUB_BITS
+		|| buf[2] != FT_HIST_MAX_BITS)
+		return (0);
+	pos = 3;
+	if (!ft_get_varint(buf, len, &pos, &head[0])
+		|| !ft_get_varint(buf, len, &pos, &head[1])
+		|| !ft_get_varint(buf, len, &pos, &head[2]))
+		return (0);
+	count = atomic_load(&hist->count);
+	if (!read_buckets(hist, buf, len, pos))
+		return (0);
+	if (atomic_load(&hist->count) == count)
+		return (1);
+	atomic_fetch_add(&hist->sum, head[0]);
+	if (atomic_load(&hist->max) < head[1])
+		atomic_store(&hist->max, head[1]);
+	if (atomic_load(&hist->inv_min) < ~head[2])
+		atomic_store(&hist->inv_min, ~head[2]);
+	return (1);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_hist_query.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:00:43 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Adds the values of one histogram to another.
+ *
+ * Used to combine histograms kept per thread, per client or per process.
+ * `src` may be updated meanwhile (values recorded during the merge may or
+ * may not be included), but `dst` must only be updated by the caller.
+ *
+ * @param dst Histogram receiving the values.
+ * @param src Histogram to add.
+ */
+void	ft_hist_merge(t_hist *dst, t_hist *src)
+{
+	unsigned long	seen;
+	int				i;
+
+	i = 0;
+	while (i < FT_HIST_BUCKETS)
+	{
+		seen = atomic_load_explicit(&src->buckets[i], memory_order_relaxed);
+		if (seen)
+			atomic_fetch_add_explicit(&dst->buckets[i], seen,
+				memory_order_relaxed);
+		i++;
+	}
+	atomic_fetch_add(&dst->sum, atomic_load(&src->sum));
+	atomic_fetch_add(&dst->count, atomic_load(&src->count));
+	seen = atomic_load(&src->max);
+	if (atomic_load(&dst->max) < seen)
+		atomic_store(&dst->max, seen);
+	seen = atomic_load(&src->inv_min);
+	if (atomic_load(&dst->inv_min) < seen)
+		atomic_store(&dst->inv_min, seen);
+}
+
+/**
+ * @brief Returns the smallest value recorded.
+ *
+ * @param hist Histogram.
+ * @return The smallest value, or 0 if the histogram is empty.
+ */
+unsigned long	ft_hist_min(t_hist *hist)
+{
+	if (atomic_load(&hist->count) == 0)
+		return (0);
+	return (~atomic_load(&hist->inv_min));
+}
+
+/**
+ * @brief Returns the mean of the values recorded.
+ *
+ * @param hist Histogram.
+ * @return The mean (rounded down), or 0 if the histogram is empty.
+ */
+unsigned long	ft_hist_mean(t_hist *hist)
+{
+	unsigned long	count;
+
+	count = atomic_load(&hist->count);
+	if (count == 0)
+		return (0);
+	return (atomic_load(&hist->sum) / count);
+}
+
+/**
+ * @brief Returns the value at a given rank.
+ *
+ * The result is the largest value of the bucket holding the rank, so it is
+ * never below the exact percentile and at most 1/2^FT_HIST_SUB_BITS above
+ * it; it is also kept within the smallest and largest values recorded,
+ * and is the largest one for a rank in the last (open-ended) bucket.
+ *
+ * @param hist Histogram.
+ * @param rank Rank in hundredths of a percent (5000 for the median, 9990
+ * for p99.9, 10000 for the maximum).
+ * @return The value, or 0 if the histogram is empty.
+ */
+unsigned long	ft_hist_percentile(t_hist *hist, unsigned int rank)
+{
+	unsigned long	target;
+	unsigned long	seen;
+	unsigned long	value;
+	int				i;
+
+	target = (atomic_load(&hist->count) * rank + 9999) / 10000;
+	if (target == 0)
+		target = 1;
+	seen = 0;
+	i = 0;
+	while (i < FT_HIST_BUCKETS && seen < target)
+		seen += atomic_load_explicit(&hist->buckets[i++],
+				memory_order_relaxed);
+	if (seen < target || i == FT_HIST_BUCKETS)
+		return (atomic_load(&hist->max));
+	value = ft_hist_lower(i) - 1;
+	if (value > atomic_load(&hist->max))
+		value = atomic_load(&hist->max);
+	if (value < ft_hist_min(hist))
+		value = ft_hist_min(hist);
+	return (value);
+}
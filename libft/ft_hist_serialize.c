@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_hist_serialize.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:00:44 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Writes the format bytes, sum, largest and smallest value.
+ *
+ * @param hist Histogram to write.
+ * @param buf Output buffer.
+ * @param size Size of `buf`.
+ * @return Bytes written, or 0 if `buf` is too small.
+ */
+static size_t	put_head(t_hist *hist, unsigned char *buf, size_t size)
+{
+	size_t	pos;
+
+	pos = 0;
+	if (!ft_put_varint(buf, size, &pos, 'H')
+		|| !ft_put_varint(buf, size, &pos, FT_HIST_SUB_BITS)
+		|| !ft_put_varint(buf, size, &pos, FT_HIST_MAX_BITS)
+		|| !ft_put_varint(buf, size, &pos, atomic_load(&hist->sum))
+		|| !ft_put_varint(buf, size, &pos, atomic_load(&hist->max))
+		|| !ft_put_varint(buf, size, &pos, ft_hist_min(hist)))
+		return (0);
+	return (pos);
+}
+
+/**
+ * @brief Writes a histogram into a buffer.
+ *
+ * The format is three bytes ('H', FT_HIST_SUB_BITS, FT_HIST_MAX_BITS),
+ * then the sum, the largest and the smallest value, then for each
+ * non-empty bucket the number of empty buckets before it and its count,
+ * all as LEB128 numbers. A histogram of n distinct buckets takes at most
+ * 3 + 30 + 13 * n bytes. Nothing is allocated, so a signal handler may
+ * serialize a histogram before handing it to `write()`.
+ *
+ * @param hist Histogram to write.
+ * @param buf Output buffer.
+ * @param size Size of `buf`.
+ * @return Bytes written, or 0 if `buf` is too small.
+ */
+size_t	ft_hist_serialize(t_hist *hist, unsigned char *buf, size_t size)
+{
+	unsigned long	seen;
+	size_t			pos;
+	int				next;
+	int				i;
+
+	pos = put_head(hist, buf, size);
+	if (pos == 0)
+		return (0);
+	next = 0;
+	i = 0;
+	while (i < FT_HIST_BUCKETS)
+	{
+		seen = atomic_load_explicit(&hist->buckets[i], memory_order_relaxed);
+		if (seen && (!ft_put_varint(buf, size, &pos, i - next)
+				|| !ft_put_varint(buf, size, &pos, seen)))
+			return (0);
+		if (seen)
+			next = i + 1;
+		i++;
+	}
+	return (pos);
+}
@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_varint.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:16:21 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:16:21 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Appends a number in LEB128 (7 bits per byte, low bits first).
+ *
+ * Numbers below 128 take one byte, and any unsigned long at most ten.
+ *
+ * @param buf Output buffer.
+ * @param size Size of `buf`.
+ * @param pos Bytes of `buf` in use, updated.
+ * @param value Number to append.
+ * @return 1 on success, 0 if `buf` is full.
+ */
+int	ft_put_varint(unsigned char *buf, size_t size, size_t *pos,
+		unsigned long value)
+{
+	while (*pos < size)
+	{
+		buf[*pos] = value & 0x7F;
+		value >>= 7;
+		if (value)
+			buf[*pos] |= 0x80;
+		(*pos)++;
+		if (!value)
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Reads a number written in LEB128 by `ft_put_varint()`.
+ *
+ * @param buf Input buffer.
+ * @param len Length of `buf`.
+ * @param pos Bytes of `buf` already read, updated.
+ * @param value Receives the number.
+ * @return 1 on success, 0 if the number is truncated or too long.
+ */
+int	ft_get_varint(const unsigned char *buf, size_t len, size_t *pos,
+		unsigned long *value)
+{
+	int	shift;
+
+	*value = 0;
+	shift = 0;
+	while (*pos < len && shift < 64)
+	{
+		*value |= (unsigned long)(buf[*pos] & 0x7F) << shift;
+		shift += 7;
+		if (!(buf[(*pos)++] & 0x80))
+			return (1);
+	}
+	return (0);
+}
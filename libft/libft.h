@@ -6,7 +6,7 @@
 /*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/07/14 20:13:11 by maria-ol          #+#    #+#             */
-/*   Updated: 2025/09/26 15:35:55 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,6 +20,7 @@
 # include <stdio.h>
 # include <limits.h>
 # include <string.h>
+# include <stdatomic.h>
 
 typedef struct s_list
 {
@@ -31,6 +32,28 @@ typedef struct s_list
 #  define BUFFER_SIZE 42
 # endif
 
+/**
+ * @brief Log-linear histogram of unsigned values (e.g. latencies in ns).
+ *
+ * Values below 2^FT_HIST_SUB_BITS get a bucket each; every power-of-two
+ * range above is split into 2^FT_HIST_SUB_BITS buckets, so a value is
+ * known within 1/2^FT_HIST_SUB_BITS of itself. Values of 2^FT_HIST_MAX_BITS
+ * and more share the last bucket. Zero-filled memory is an empty
+ * histogram; `inv_min` holds the complement of the smallest value.
+ */
+# define FT_HIST_SUB_BITS 3
+# define FT_HIST_MAX_BITS 40
+# define FT_HIST_BUCKETS 304
+
+typedef struct s_hist
+{
+	atomic_ulong	count;
+	atomic_ulong	sum;
+	atomic_ulong	max;
+	atomic_ulong	inv_min;
+	atomic_ulong	buckets[FT_HIST_BUCKETS];
+}	t_hist;
+
 size_t	ft_strlen(const char *str);
 int		ft_isalpha(int chr);
 int		ft_isalnum(int chr);
@@ -89,6 +112,26 @@ int		ft_putnbr_unsigned(unsigned int n);
 int		ft_print_hex(unsigned long n, char specifier);
 int		ft_printptr(unsigned long n);
 
+//histogram
+int				ft_hist_index(unsigned long value);
+unsigned long	ft_hist_lower(int index);
+void			ft_hist_reset(t_hist *hist);
+void			ft_hist_record(t_hist *hist, unsigned long value);
+void			ft_hist_merge(t_hist *dst, t_hist *src);
+unsigned long	ft_hist_percentile(t_hist *hist, unsigned int rank);
+unsigned long	ft_hist_min(t_hist *hist);
+unsigned long	ft_hist_mean(t_hist *hist);
+size_t			ft_hist_serialize(t_hist *hist, unsigned char *buf,
+					size_t size);
+int				ft_hist_deserialize(t_hist *hist, const unsigned char *buf,
+					size_t len);
+
+//varint
+int		ft_put_varint(unsigned char *buf, size_t size, size_t *pos,
+			unsigned long value);
+int		ft_get_varint(const unsigned char *buf, size_t len, size_t *pos,
+			unsigned long *value);
+
 //get next line
 char	*get_next_line(int fd);
 void	ft_memdel(void **address_ptr);
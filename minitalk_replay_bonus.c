@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   minitalk_replay_bonus.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:18:01 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:55:05 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return Time in nanoseconds.
+ */
+static long	replay_clock(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000000L + now.tv_nsec);
+}
+
+/**
+ * @brief Sleeps until a point of the monotonic clock.
+ *
+ * @param at_ns Time to wake up at, in nanoseconds.
+ */
+static void	replay_wait(long at_ns)
+{
+	struct timespec	at;
+
+	at.tv_sec = at_ns / 1000000000L;
+	at.tv_nsec = at_ns % 1000000000L;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &at, NULL) == EINTR)
+		;
+}
+
+/**
+ * @brief Prints a label, a number and a unit on standard error.
+ *
+ * @param label Text before the number.
+ * @param n Number to print.
+ * @param unit Text after the number.
+ */
+static void	put_count(const char *label, unsigned long n, const char *unit)
+{
+	char	digits[24];
+	int		i;
+
+	i = sizeof(digits);
+	digits[--i] = '\0';
+	digits[--i] = '0' + n % 10;
+	while (n >= 10)
+	{
+		n /= 10;
+		digits[--i] = '0' + n % 10;
+	}
+	ft_putstr_fd((char *)label, 2);
+	ft_putstr_fd(digits + i, 2);
+	ft_putstr_fd((char *)unit, 2);
+}
+
+/**
+ * @brief Prints what was replayed, and how fast, on standard error.
+ *
+ * @param replay Replayed log.
+ * @param elapsed_ns Duration of the replay.
+ */
+static void	replay_report(t_replay *replay, long elapsed_ns)
+{
+	put_count("Replayed ", replay->signals, " signals");
+	put_count(" in ", elapsed_ns / 1000, " us");
+	if (replay->signals)
+		put_count(" (", elapsed_ns / replay->signals, " ns per signal)");
+	put_count("\nRecorded over ", replay->at_ns / 1000, " us\n");
+	put_count("Messages: ", replay->messages, "");
+	put_count(" (", replay->bytes, " bytes)");
+	if (replay->out_of_band)
+		put_count(", ", replay->out_of_band,
+			" more out of band (pull, shared memory or pipe), not replayed");
+	ft_putchar_fd('\n', 2);
+	if (replay->pos < replay->len)
+		put_count("Log truncated after ", replay->pos, " bytes\n");
+}
+
+/**
+ * @brief Entry point of the signal log player.
+ *
+ * Usage: ./minitalk_replay [--max] <log>
+ *
+ * Feeds a log written by `server_bonus --record` (see `record_start()`) to
+ * the server's decoder and writes the messages to standard output, as the
+ * server did, without sending or receiving a single signal, and in the
+ * order the server wrote them: a log recorded in `--fifo` mode is replayed
+ * with the same admission queue. By default the
+ * records are fed at the pace they were logged at; with `--max` they are
+ * fed as fast as the decoder takes them, which benchmarks the decoding and
+ * output path alone. What was replayed and how long it took is printed on
+ * standard error.
+ *
+ * @param argc Argument count (2, or 3 with `--max`).
+ * @param argv Argument vector.
+ * @return 0 on success, 1 on failure.
+ */
+int	main(int argc, char **argv)
+{
+	static t_server	server;
+	t_replay		replay;
+	t_record		rec;
+	long			start;
+	int				max;
+
+	max = (argc == 3 && ft_strncmp(argv[1], "--max", 6) == 0);
+	if (argc != 2 && !max)
+	{
+		ft_putendl_fd("Usage: ./minitalk_replay [--max] <log>", 2);
+		return (1);
+	}
+	if (!replay_open(argv[argc - 1], &replay))
+		ft_error();
+	server.fifo = replay.fifo;
+	start = replay_clock();
+	while (replay_next(&replay, &rec))
+	{
+		if (!max)
+			replay_wait(start + replay.at_ns);
+		replay.signals++;
+		replay_feed(&server, &replay, &rec);
+	}
+	replay_report(&replay, replay_clock() - start);
+	return (0);
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   minitalk_stat_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:58:51 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Prints a gap histogram saved with `--save` (`--load path`).
+ *
+ * @param path Path of the saved histogram.
+ * @return 0 (exits with an error if it cannot be read).
+ */
+static int	load_gaps(const char *path)
+{
+	static t_hist	gaps;
+
+	if (!stat_load(path, &gaps))
+		ft_error();
+	stat_gaps("Saved inter-signal gaps", &gaps);
+	return (0);
+}
+
+/**
+ * @brief Prints the gaps of the whole worker pool, and saves them.
+ *
+ * The gaps of the server and of each of its workers are merged (see
+ * `stat_pool()`), and printed if there is more than one process. With
+ * `--save` the merged histogram is written to a file after each snapshot.
+ *
+ * @param pid PID of the server.
+ * @param save Path given with `--save`, or NULL.
+ */
+static void	print_pool(pid_t pid, const char *save)
+{
+	static t_hist	pool;
+	int				count;
+
+	ft_hist_reset(&pool);
+	count = stat_pool(pid, &pool);
+	if (count > 1)
+	{
+		ft_printf("Pool of %d processes, ", count);
+		stat_gaps("inter-signal gaps", &pool);
+	}
+	if (save && !stat_save(save, &pool))
+		ft_error();
+}
+
+/**
+ * @brief Prints the usage of `minitalk_stat` on standard error.
+ *
+ * @return 1, the exit status of a bad command line.
+ */
+static int	usage(void)
+{
+	ft_putstr_fd("Usage: ./minitalk_stat [--watch seconds] ", 2);
+	ft_putendl_fd("[--save path] <server>", 2);
+	ft_putendl_fd("       ./minitalk_stat --load path", 2);
+	return (1);
+}
+
+/**
+ * @brief Reads the options before the server argument.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param watch Receives the `--watch` period (0 without it).
+ * @param save Receives the `--save` path (NULL without it).
+ * @return 1 if the options are valid and one server argument follows.
+ */
+static int	parse_stat(int argc, char **argv, int *watch, char **save)
+{
+	int	i;
+
+	*watch = 0;
+	*save = NULL;
+	i = 1;
+	while (i + 2 < argc)
+	{
+		if (ft_strncmp(argv[i], "--watch", 8) == 0)
+		{
+			*watch = ft_atoi(argv[i + 1]);
+			if (*watch <= 0)
+				return (0);
+		}
+		else if (ft_strncmp(argv[i], "--save", 7) == 0)
+			*save = argv[i + 1];
+		else
+			return (0);
+		i += 2;
+	}
+	return (i == argc - 1);
+}
+
+/**
+ * @brief Entry point of the metrics viewer.
+ *
+ * Usage: ./minitalk_stat [--watch seconds] [--save path] <server>
+ *        ./minitalk_stat --load path
+ *
+ * Prints the metrics of a running `server_bonus` (given by PID, name or
+ * pidfile, see `server_lookup()`): signals received, bytes decoded,
+ * messages completed, resyncs, active sessions, the histogram of the gaps
+ * between signals, and the same per client. The server is neither
+ * signalled nor paused: its counters are read from shared memory (see
+ * `metrics_start()`). With `--watch` a new snapshot is printed every given
+ * number of seconds, until the server exits. Worker servers have metrics
+ * of their own; their PIDs are listed in the worker directory, and the
+ * gaps of the whole pool are merged (see `print_pool()`). `--save` keeps
+ * those gaps in a file that `--load` prints later, e.g. to compare two
+ * runs.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return 0 on success, 1 on failure.
+ */
+int	main(int argc, char **argv)
+{
+	t_metrics	*metrics;
+	char		*save;
+	pid_t		pid;
+	int			watch;
+
+	if (argc == 3 && ft_strncmp(argv[1], "--load", 7) == 0)
+		return (load_gaps(argv[2]));
+	if (!parse_stat(argc, argv, &watch, &save))
+		return (usage());
+	pid = server_lookup(argv[argc - 1]);
+	metrics = stat_open(pid);
+	if (!metrics)
+		ft_error();
+	stat_print(metrics);
+	print_pool(pid, save);
+	while (watch > 0 && sleep(watch) == 0 && kill(pid, 0) == 0)
+	{
+		ft_printf("\n");
+		stat_print(metrics);
+		print_pool(pid, save);
+	}
+	return (0);
+}
@@ -6,83 +6,57 @@
 /*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/10/15 17:00:00 by maria-ol          #+#    #+#             */
-/*   Updated: 2025/10/16 22:47:53 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 21:55:05 by maria-ol         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "includes/minitalk_bonus.h"
 
 /**
- * @brief Global variable holding the current client PID.
+ * @brief Empty handler for the signals read from the signalfd.
  *
- * Used by the server to identify which process sent the signal.
+ * @param sig Signal number (unused).
  */
-pid_t	g_client_pid = 0;
-
-/**
- * @brief Handles incoming signals (SIGUSR1 and SIGUSR2) from the client.
- *
- * Each signal represents one bit of a character:
- * - SIGUSR1 → bit 0
- * - SIGUSR2 → bit 1
- *
- * The handler uses two static variables:
- * - `current_char` accumulates the bits to form a full character.
- * - `bit_count` tracks how many bits have been received.
- * 
- * Once 8 bits are received, a full character is reconstructed.
- * If the character is '\0', a SIGUSR1 is sent back to the client to confirm 
- * completion.
- * Otherwise, the character is printed and the next bit is awaited.
- *
- * @param sig Signal number (SIGUSR1 or SIGUSR2).
- * @param info Signal info structure containing sender PID.
- * @param context Unused pointer to signal context (required by SA_SIGINFO).
- */
-void	signal_handler(int sig, siginfo_t *info, void *context)
+static void	ignore_signal(int sig)
 {
-	static char	current_char = 0;
-	static int	bit_count = 0;
-
-	(void)context;
-	g_client_pid = info->si_pid;
-	if (sig == SIGUSR2)
-		current_char |= (1 << bit_count);
-	bit_count++;
-	if (bit_count == 8)
-	{
-		if (current_char == '\0')
-			kill(g_client_pid, SIGUSR1);
-		else
-		{
-			write(1, &current_char, 1);
-			kill(g_client_pid, SIGUSR2);
-		}
-		current_char = 0;
-		bit_count = 0;
-	}
-	else
-		kill(g_client_pid, SIGUSR2);
+	(void)sig;
 }
 
 /**
- * @brief Configures signal handling for SIGUSR1 and SIGUSR2.
+ * @brief Blocks every signal a client may send to the server.
+ *
+ * SIGUSR1, SIGUSR2, the real-time alphabet, SIG_PAYLOAD and SIG_HELLO are
+ * blocked: `serve()` reads them from a signalfd. Decoding therefore never
+ * runs inside a signal handler, where allocating a message buffer would not
+ * be safe, and a signal can never interrupt the update of a session.
  *
- * This function sets up a `sigaction` structure that links both signals
- * to the `signal_handler()` function. The flag `SA_SIGINFO` is used so that
- * the handler can access additional information (like the client's PID)
- * via the `siginfo_t` parameter.
+ * They also get an empty handler. It never runs while the signals are
+ * blocked, but it makes them appear as caught in /proc/<pid>/status, which
+ * is how clients tell this server from a legacy one (see
+ * `server_accepts()`), and the default action of real-time signals
+ * (terminating the process) can never apply.
  *
+ * @param set Receives the set of blocked signals.
  */
-void	setup_signals(void)
+void	setup_signals(sigset_t *set)
 {
 	struct sigaction	sa;
+	int					sig;
 
-	sa.sa_sigaction = signal_handler;
-	sa.sa_flags = SA_SIGINFO;
+	alphabet_mask(set);
+	if (alphabet_available())
+		sigaddset(set, SIG_HELLO);
+	sigprocmask(SIG_BLOCK, set, NULL);
+	ft_bzero(&sa, sizeof(sa));
+	sa.sa_handler = ignore_signal;
 	sigemptyset(&sa.sa_mask);
-	sigaction(SIGUSR1, &sa, NULL);
-	sigaction(SIGUSR2, &sa, NULL);
+	sig = 1;
+	while (sig <= SIGRTMAX)
+	{
+		if (sigismember(set, sig) == 1)
+			sigaction(sig, &sa, NULL);
+		sig++;
+	}
 }
 
 /**
@@ -91,20 +65,71 @@ void	setup_signals(void)
  * The server prints its PID so that clients know where to send messages.
  * Then it enters an infinite loop, waiting for incoming signals.
  *
- * The use of `pause()` inside the `while (1)` loop puts the process in a 
- * sleeping state until a signal is received waking only when a signal arrives 
- * to be processed by the handler.
+ * Usage: ./server_bonus [--fifo] [--threads n] [--workers n]
+ * [--name name] [--pidfile path] [--ready-fd fd] [--prewarm] [--trace]
+ * [--record path]
+ *
+ * With `--fifo` the server outputs messages strictly one at a time: a
+ * client that starts while another is being served waits in a bounded
+ * queue (see `QUEUE_SIZE`) and is acknowledged when its turn comes.
+ *
+ * With `--threads n` the main thread only receives signals, n decoder
+ * threads decode the clients (sharded by PID) and a writer thread prints
+ * the messages, spreading the work of many concurrent clients over
+ * several cores.
+ *
+ * With `--workers n` the server also forks n worker servers and publishes
+ * their PIDs in a directory file; `client_bonus` picks one of them from
+ * its own PID, so signal delivery is spread over n + 1 processes.
+ *
+ * With `--prewarm` the server binds its symbols, faults in its tables and
+ * buffers and locks them in RAM before printing its PID (see `prewarm()`),
+ * so the first messages are as fast as the following ones.
+ *
+ * Every server process (master and workers alike) keeps its counters in
+ * shared memory, where `minitalk_stat` reads them (see `metrics_start()`).
+ * With `--trace` each of them also records the timeline of the signals it
+ * reads, handles and acknowledges, and of the messages it writes, and
+ * dumps it as Chrome trace JSON when it is stopped (see `trace_start()`).
+ * With `--record` each of them logs the signals it reads to a compact
+ * binary file, which `minitalk_replay` feeds back into the decoder without
+ * real signals (see `record_start()`).
+ *
+ * Once it is ready to serve, the server can publish its PID for launch
+ * scripts and clients (see `server_publish()`), so they do not have to
+ * scrape the "Server PID" line or sleep before starting clients.
+ *
+ * The soft RLIMIT_SIGPENDING is raised first, so that windowed clients can
+ * keep as many queued signals pending on the server as the system allows;
+ * each client's window is capped to a share of it during the handshake.
  *
+ * @param argc Argument count.
+ * @param argv Argument vector (options).
  * @return Always returns 0.
  */
-int	main(void)
+int	main(int argc, char **argv)
 {
-	pid_t	server_pid;
+	static t_server	server;
+	sigset_t		set;
 
-	setup_signals();
-	server_pid = getpid();
-	ft_printf("Server PID: %d\n", server_pid);
-	while (1)
-		pause();
+	parse_options(argc, argv, &server);
+	if (server.prewarm)
+		prewarm_bind(argv);
+	server.window = window_size(raise_sigpending());
+	setup_signals(&set);
+	if (server.prewarm)
+		prewarm(&server);
+	ft_printf("Server PID: %d\n", getpid());
+	if (server.workers > 0 && !workers_start(&server))
+		ft_error();
+	metrics_start();
+	if (server.trace)
+		trace_start("server");
+	if (server.record && !record_start(&server))
+		ft_error();
+	if (server.threads > 0 && !pipeline_start(&server, server.threads))
+		ft_error();
+	server_publish(&server);
+	serve(&server, &set);
 	return (0);
 }
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   alphabet_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:45:29 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 19:57:13 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Returns the real-time signal that carries a given symbol.
+ *
+ * The alphabet uses `ALPHABET_SIZE` consecutive real-time signals starting
+ * at SIGRTMIN, so one `kill()` transports `ALPHABET_BITS` bits.
+ *
+ * @param symbol Value in [0, ALPHABET_SIZE).
+ * @return Signal number SIGRTMIN + symbol.
+ */
+int	symbol_signal(int symbol)
+{
+	return (SIGRTMIN + symbol);
+}
+
+/**
+ * @brief Decodes the value carried by a data signal.
+ *
+ * - SIGUSR1 / SIGUSR2 → one bit (0 / 1), as in the standard protocol.
+ * - SIGRTMIN + n      → `ALPHABET_BITS` bits holding the symbol n.
+ *
+ * @param sig Received signal number.
+ * @param value Receives the decoded bits.
+ * @return Number of bits carried by the signal, 0 if it is not a data signal.
+ */
+int	signal_symbol(int sig, int *value)
+{
+	if (sig == SIGUSR1 || sig == SIGUSR2)
+	{
+		*value = (sig == SIGUSR2);
+		return (1);
+	}
+	if (sig >= SIGRTMIN && sig < SIGRTMIN + ALPHABET_SIZE)
+	{
+		*value = sig - SIGRTMIN;
+		return (ALPHABET_BITS);
+	}
+	return (0);
+}
+
+/**
+ * @brief Checks that the system provides enough real-time signals.
+ *
+ * @return 1 if the alphabet and the payload signals (up to SIG_PAYLOAD_ACK)
+ * all exist.
+ */
+int	alphabet_available(void)
+{
+	return (SIG_PAYLOAD_ACK <= SIGRTMAX);
+}
+
+/**
+ * @brief Fills a signal set with every signal that can carry data.
+ *
+ * Used as the handler mask so that decoding one signal is never interrupted
+ * by another data signal, whichever client sent it. The set holds SIGUSR1,
+ * SIGUSR2, the alphabet and SIG_PAYLOAD.
+ *
+ * @param set Signal set to fill (previous content is discarded).
+ */
+void	alphabet_mask(sigset_t *set)
+{
+	int	symbol;
+
+	sigemptyset(set);
+	sigaddset(set, SIGUSR1);
+	sigaddset(set, SIGUSR2);
+	sigaddset(set, SIG_PAYLOAD);
+	symbol = 0;
+	while (symbol < ALPHABET_SIZE)
+	{
+		sigaddset(set, symbol_signal(symbol));
+		symbol++;
+	}
+}
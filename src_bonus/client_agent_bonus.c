@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_agent_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:34:14 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:56:13 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Current time of the monotonic clock, in milliseconds.
+ *
+ * @return Milliseconds since an arbitrary point.
+ */
+static long	now_ms(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Creates (or reuses) the agent's FIFO and opens it.
+ *
+ * The FIFO is opened for reading and writing, so it never reports an end
+ * of file when the last producer closes it, and its buffer is grown to
+ * PIPE_SIZE bytes so producers block less while a batch is being sent.
+ *
+ * @param path Path of the FIFO.
+ * @return Descriptor of the FIFO, or -1 if the path is not a FIFO.
+ */
+static int	agent_open(const char *path)
+{
+	struct stat	info;
+	int			fd;
+
+	if (mkfifo(path, 0600) == -1 && errno != EEXIST)
+		return (-1);
+	fd = open(path, O_RDWR | O_NONBLOCK);
+	if (fd < 0)
+		return (-1);
+	if (fstat(fd, &info) == -1 || !S_ISFIFO(info.st_mode))
+	{
+		close(fd);
+		return (-1);
+	}
+	fcntl(fd, F_SETPIPE_SZ, PIPE_SIZE);
+	return (fd);
+}
+
+/**
+ * @brief Sends one batch as a message and waits for its completion.
+ *
+ * The session is only negotiated again when the server did not keep it
+ * (FEAT_KEEP). SIGUSR1 is blocked by `run_agent()`, so the completion is
+ * read here instead of ending the process; the acknowledgments still queued
+ * for the last frames are then discarded, so the next batch starts with a
+ * clean window.
+ *
+ * @param opts Client options (`wanted` features, negotiated features).
+ * @param batch Batch to send (NUL-terminated).
+ */
+static void	agent_flush(t_options *opts, char *batch)
+{
+	sigset_t		set;
+	struct timespec	none;
+	int				features;
+
+	if (!(opts->features & FEAT_KEEP))
+	{
+		opts->features = opts->wanted;
+		negotiate(opts);
+	}
+	if (!(opts->features & FEAT_PAYLOAD))
+		ft_error();
+	features = opts->features;
+	opts->message = batch;
+	send_message(opts);
+	sigemptyset(&set);
+	sigaddset(&set, SIGUSR1);
+	sigaddset(&set, SIG_PAYLOAD_ACK);
+	while (sigwaitinfo(&set, NULL) != SIGUSR1)
+		;
+	ft_bzero(&none, sizeof(none));
+	while (sigtimedwait(&set, NULL, &none) > 0)
+		;
+	opts->features = features;
+	opts->frames = 0;
+	opts->acked = 0;
+}
+
+/**
+ * @brief Waits for producer bytes and adds them to the pending batch.
+ *
+ * Without pending bytes it waits as long as it takes; otherwise only until
+ * the batch is due. The deadline is set by the first byte of a batch.
+ *
+ * @param fd Descriptor of the FIFO.
+ * @param batch Pending batch, kept NUL-terminated.
+ * @param len Bytes pending, updated.
+ * @param deadline Time (see `now_ms()`) the batch is due, updated.
+ */
+static void	agent_read(int fd, char *batch, size_t *len, long *deadline)
+{
+	struct pollfd	pfd;
+	ssize_t			got;
+	long			timeout;
+
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	timeout = -1;
+	if (*len > 0)
+		timeout = *deadline - now_ms();
+	if (*len > 0 && timeout < 0)
+		timeout = 0;
+	if (poll(&pfd, 1, timeout) <= 0)
+		return ;
+	got = read(fd, batch + *len, AGENT_BATCH - *len);
+	if (got <= 0)
+		return ;
+	if (*len == 0)
+		*deadline = now_ms() + AGENT_DELAY_MS;
+	*len += got;
+	batch[*len] = '\0';
+}
+
+/**
+ * @brief Runs the client as a long-lived agent for local producers.
+ *
+ * Usage: ./client_bonus --agent <server> <fifo>
+ *
+ * Producers write their messages to the FIFO (e.g. `echo hi > fifo`).
+ * Like Nagle's algorithm, the agent coalesces what they write into one
+ * batch, sent when it reaches AGENT_BATCH bytes or AGENT_DELAY_MS after
+ * its first byte, whichever comes first. Every batch goes over the same
+ * session, negotiated with the first batch and kept by the server
+ * (FEAT_KEEP), with the best transport for its size; pulls and stripes are
+ * left out, as they end the client process. Batches are sent as text: a
+ * NUL byte ends one.
+ * Producers pay neither a fork/exec nor a handshake per message. With
+ * `--stats`, the totals so far are printed after each batch.
+ *
+ * @param opts Client options (`message` holds the FIFO path).
+ */
+void	run_agent(t_options *opts)
+{
+	static char	batch[AGENT_BATCH + 1];
+	sigset_t	done;
+	size_t		len;
+	long		deadline;
+	int			fd;
+
+	fd = agent_open(opts->message);
+	if (fd < 0)
+		ft_error();
+	sigemptyset(&done);
+	sigaddset(&done, SIGUSR1);
+	sigprocmask(SIG_BLOCK, &done, NULL);
+	opts->wanted = (opts->features | FEAT_KEEP) & ~(FEAT_PULL | FEAT_STRIPES);
+	opts->features = 0;
+	len = 0;
+	while (1)
+	{
+		agent_read(fd, batch, &len, &deadline);
+		if (len > 0 && (len == AGENT_BATCH || now_ms() >= deadline))
+		{
+			agent_flush(opts, batch);
+			stats_report();
+			len = 0;
+		}
+	}
+}
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_args_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:45:29 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Prints the client usage line on standard error.
+ */
+static void	print_usage(void)
+{
+	ft_putendl_fd("Usage: ./client_bonus [--legacy] [--rt] [--payload] "
+		"[--pull] [--shm] [--pipe] [--stripes n] [--stats] [--trace] "
+		"<server> <message | ->", 2);
+	ft_putendl_fd("       ./client_bonus [flags] --agent <server> <fifo>", 2);
+}
+
+/**
+ * @brief Applies one command-line switch that selects a client mode.
+ *
+ * @param opts Options being filled.
+ * @param flag Flag to apply.
+ * @return 1 if the flag is known, 0 otherwise.
+ */
+static int	parse_switch(t_options *opts, const char *flag)
+{
+	if (ft_strncmp(flag, "--legacy", 9) == 0)
+		opts->legacy = 1;
+	else if (ft_strncmp(flag, "--agent", 8) == 0)
+		opts->agent = 1;
+	else if (ft_strncmp(flag, "--stats", 8) == 0)
+		opts->stats = 1;
+	else if (ft_strncmp(flag, "--trace", 8) == 0)
+		opts->trace = 1;
+	else
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Applies one command-line flag to the client options.
+ *
+ * `--stripes` takes the next argument as its value (2 to STRIPES_MAX) and
+ * implies payload frames, which carry the stripes. `--pull`, `--shm` and
+ * `--pipe` also imply them, as the fallback when the server cannot read
+ * the message, attach to the ring or create the pipe. Other flags are
+ * handed to `parse_switch()`.
+ *
+ * @param opts Options being filled.
+ * @param argv Argument vector.
+ * @param i Index of the flag, moved past its value if it has one.
+ * @return 1 if the flag is known, 0 otherwise.
+ */
+static int	parse_flag(t_options *opts, char **argv, int *i)
+{
+	if (ft_strncmp(argv[*i], "--stripes", 10) == 0 && argv[*i + 1])
+	{
+		opts->stripes = ft_atoi(argv[++(*i)]);
+		opts->features |= FEAT_PAYLOAD | FEAT_STRIPES;
+		return (opts->stripes > 1 && opts->stripes <= STRIPES_MAX);
+	}
+	if (ft_strncmp(argv[*i], "--rt", 5) == 0)
+		opts->features |= FEAT_ALPHABET;
+	else if (ft_strncmp(argv[*i], "--payload", 10) == 0)
+		opts->features |= FEAT_PAYLOAD;
+	else if (ft_strncmp(argv[*i], "--pull", 7) == 0)
+		opts->features |= FEAT_PAYLOAD | FEAT_PULL;
+	else if (ft_strncmp(argv[*i], "--shm", 6) == 0)
+		opts->features |= FEAT_PAYLOAD | FEAT_SHM;
+	else if (ft_strncmp(argv[*i], "--pipe", 7) == 0)
+		opts->features |= FEAT_PAYLOAD | FEAT_PIPE;
+	else
+		return (parse_switch(opts, argv[*i]));
+	return (1);
+}
+
+/**
+ * @brief Parses the client command line.
+ *
+ * Usage: ./client_bonus [--legacy] [--rt] [--payload] [--pull] [--shm]
+ * [--pipe] [--stripes n] [--stats] [--trace] <server> <message | ->
+ *
+ * Flags come first and are followed by exactly two positional arguments.
+ * `--rt`, `--payload`, `--pull`, `--shm`, `--pipe` and `--stripes` restrict
+ * the features offered during the handshake (all of them are offered by
+ * default) and `--legacy` skips the handshake. On error the usage line is
+ * printed and 0 is returned. The server is given by PID, name or pidfile
+ * (see `server_lookup()`); one that cannot be found is reported with
+ * `ft_error()`. A message `-` is read from standard input. `--stats`
+ * prints transfer statistics once the message is confirmed, and `--trace`
+ * records the timeline of the signals (see `trace_start()`).
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param opts Options to fill (zeroed first).
+ * @return 1 if the command line is valid, 0 otherwise.
+ */
+int	parse_args(int argc, char **argv, t_options *opts)
+{
+	int	i;
+
+	ft_bzero(opts, sizeof(t_options));
+	i = 1;
+	while (i < argc && ft_strncmp(argv[i], "--", 2) == 0)
+	{
+		if (!parse_flag(opts, argv, &i))
+			break ;
+		i++;
+	}
+	if (argc - i != 2)
+	{
+		print_usage();
+		return (0);
+	}
+	opts->server_pid = server_lookup(argv[i]);
+	if (opts->server_pid <= 0)
+		ft_error();
+	opts->message = read_message(opts, argv[i + 1]);
+	if (opts->features == 0)
+		opts->features = FEAT_ALL;
+	if (!alphabet_available())
+		opts->legacy = 1;
+	return (1);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_handshake_bonus.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:53:25 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Tests one bit of a "SigBlk:" or "SigCgt:" line of /proc status.
+ *
+ * @param line Status line; the mask is hexadecimal, bit n-1 is signal n.
+ * @param sig Signal to look for.
+ * @return 1 if the signal is in the mask, 0 otherwise.
+ */
+static int	mask_has(const char *line, int sig)
+{
+	unsigned long	mask;
+	char			*digit;
+	int				i;
+
+	mask = 0;
+	i = 7;
+	while (ft_isspace(line[i]))
+		i++;
+	digit = ft_strchr("0123456789abcdef", ft_tolower(line[i]));
+	while (line[i] && digit)
+	{
+		mask = mask * 16 + (digit - "0123456789abcdef");
+		i++;
+		digit = ft_strchr("0123456789abcdef", ft_tolower(line[i]));
+	}
+	return ((mask >> (sig - 1)) & 1);
+}
+
+/**
+ * @brief Opens /proc/<pid>/status.
+ *
+ * @param pid PID of the process.
+ * @return File descriptor, or -1 if the file cannot be opened.
+ */
+static int	open_status(pid_t pid)
+{
+	char	path[32];
+	char	*num;
+
+	num = ft_itoa(pid);
+	if (!num)
+		return (-1);
+	ft_strlcpy(path, "/proc/", sizeof(path));
+	ft_strlcat(path, num, sizeof(path));
+	ft_strlcat(path, "/status", sizeof(path));
+	free(num);
+	return (open(path, O_RDONLY));
+}
+
+/**
+ * @brief Checks that a process handles a signal instead of dying from it.
+ *
+ * The default action of a real-time signal is to terminate the process, so
+ * a legacy server must never receive one. /proc/<pid>/status tells whether
+ * the process catches (SigCgt) or blocks (SigBlk, then reads it with
+ * `sigwaitinfo()`) the signal. Without /proc the answer is no.
+ *
+ * @param pid PID of the process.
+ * @param sig Signal to check.
+ * @return 1 if the signal is caught or blocked, 0 otherwise.
+ */
+int	server_accepts(pid_t pid, int sig)
+{
+	char	*line;
+	int		fd;
+	int		found;
+
+	fd = open_status(pid);
+	found = 0;
+	line = get_next_line(fd);
+	while (line)
+	{
+		if (!ft_strncmp(line, "SigBlk:", 7) || !ft_strncmp(line, "SigCgt:", 7))
+			found |= mask_has(line, sig);
+		free(line);
+		line = get_next_line(fd);
+	}
+	if (fd >= 0)
+		close(fd);
+	return (found);
+}
+
+/**
+ * @brief Waits for the server's SIG_HELLO answer.
+ *
+ * @param reply Receives the handshake value.
+ * @return 1 if a version PROTO_VERSION answer arrived in time, 0 otherwise.
+ */
+static int	wait_hello(int *reply)
+{
+	sigset_t		set;
+	siginfo_t		info;
+	struct timespec	timeout;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIG_HELLO);
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = HELLO_TIMEOUT_NS;
+	if (sigtimedwait(&set, &info, &timeout) != SIG_HELLO)
+		return (0);
+	*reply = info.si_value.sival_int;
+	trace_mark(TRACE_ACK, SIG_HELLO, info.si_pid, *reply);
+	return (((*reply >> 24) & 0x7F) == PROTO_VERSION);
+}
+
+/**
+ * @brief Negotiates the session features and window with the server.
+ *
+ * The client advertises the features it wants (all of them unless `--rt`
+ * or `--payload` narrowed the list) and the window sized from its own
+ * RLIMIT_SIGPENDING. It keeps the features the server accepted and the
+ * smaller window. With `--legacy`, a server that does not handle SIG_HELLO
+ * or a server that does not answer, no feature is kept and the message is
+ * sent with the 1-bit SIGUSR1/SIGUSR2 protocol. An answered SIG_HELLO
+ * counts as one signal in the `--stats` report.
+ *
+ * @param opts Client options, updated with the negotiated parameters.
+ */
+void	negotiate(t_options *opts)
+{
+	int	reply;
+
+	opts->window = window_size(raise_sigpending());
+	if (opts->legacy || !server_accepts(opts->server_pid, SIG_HELLO)
+		|| queue_signal(opts->server_pid, SIG_HELLO,
+			hello_pack(opts->features, opts->window)) == -1
+		|| !wait_hello(&reply))
+	{
+		opts->features = 0;
+		return ;
+	}
+	stats_count(0, 1, 0);
+	opts->features &= hello_features(reply);
+	if (hello_window(reply) < opts->window)
+		opts->window = hello_window(reply);
+	if (opts->window < 1)
+		opts->window = 1;
+}
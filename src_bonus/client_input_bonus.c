@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_input_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:08:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Makes room for more bytes in a buffer of `len` bytes in use.
+ *
+ * A full buffer is moved to a new one, twice as large plus 4096 bytes (and
+ * its terminator). Running out of memory is reported with `ft_error()`.
+ *
+ * @param buf Buffer to grow (released if moved), may be NULL.
+ * @param len Bytes of `buf` in use.
+ * @param cap Capacity of `buf`, without its terminator (updated).
+ * @return The buffer, with room for at least one more byte.
+ */
+static char	*grow_buffer(char *buf, size_t len, size_t *cap)
+{
+	char	*grown;
+
+	if (len < *cap)
+		return (buf);
+	*cap = *cap * 2 + 4096;
+	grown = malloc(*cap + 1);
+	if (!grown)
+		ft_error();
+	if (buf)
+		ft_memcpy(grown, buf, len);
+	free(buf);
+	return (grown);
+}
+
+/**
+ * @brief Returns the message argument, read from standard input if `-`.
+ *
+ * Standard input lifts the size limit of a single command-line argument;
+ * the message ends at the first NUL byte, as one given on the command line
+ * would. For the agent, the argument is its FIFO and is kept as is. A
+ * message that cannot be read is reported with `ft_error()`.
+ *
+ * @param opts Client options (`agent` is already set).
+ * @param arg Message argument.
+ * @return The message.
+ */
+char	*read_message(t_options *opts, char *arg)
+{
+	char	*buf;
+	size_t	len;
+	size_t	cap;
+	ssize_t	got;
+
+	if (opts->agent || ft_strncmp(arg, "-", 2) != 0)
+		return (arg);
+	len = 0;
+	cap = 0;
+	buf = NULL;
+	got = 1;
+	while (got > 0)
+	{
+		buf = grow_buffer(buf, len, &cap);
+		got = read(0, buf + len, cap - len);
+		if (got > 0)
+			len += got;
+	}
+	if (got < 0)
+		ft_error();
+	buf[len] = '\0';
+	return (buf);
+}
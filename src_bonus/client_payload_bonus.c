@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_payload_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:47:52 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:14:28 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Queues one payload frame to the server.
+ *
+ * EAGAIN is absorbed by the backoff in `queue_signal()`; any other failure
+ * (e.g. the server is gone) is fatal.
+ *
+ * @param server_pid PID of the server process.
+ * @param value Packed frame.
+ */
+static void	send_frame(pid_t server_pid, int value)
+{
+	if (queue_signal(server_pid, SIG_PAYLOAD, value) == -1)
+		ft_error();
+	stats_count(0, 1, 0);
+}
+
+/**
+ * @brief Consumes one SIG_PAYLOAD_ACK.
+ *
+ * SIG_PAYLOAD_ACK is blocked by `setup_signal_handlers()` and picked up
+ * synchronously; real-time signals are queued, so every acknowledgment
+ * is received exactly once. They come back in order, so with `--stats`
+ * each one is matched with the send time of the oldest frame in flight,
+ * and timed when it is consumed. The value queued with it is kept in
+ * `opts->answer` (see `send_pipe()`); QUEUE_BUSY ends the client (see
+ * `server_busy()`).
+ *
+ * @param opts Client options (frame counters, one more frame acknowledged).
+ * @param block 1 to wait for the acknowledgment, 0 to only take one that
+ * has already arrived.
+ * @return 1 if an acknowledgment was consumed, 0 if none had arrived.
+ */
+int	wait_payload_ack(t_options *opts, int block)
+{
+	static const struct timespec	now = {0, 0};
+	sigset_t						acks;
+	siginfo_t						info;
+	int								sig;
+
+	sigemptyset(&acks);
+	sigaddset(&acks, SIG_PAYLOAD_ACK);
+	sig = -1;
+	while (sig != SIG_PAYLOAD_ACK)
+	{
+		if (block)
+			sig = sigwaitinfo(&acks, &info);
+		else
+			sig = sigtimedwait(&acks, &info, &now);
+		if (sig == -1 && errno == EAGAIN)
+			return (0);
+	}
+	opts->answer = info.si_value.sival_int;
+	server_busy(opts->answer);
+	trace_mark(TRACE_ACK, SIG_PAYLOAD_ACK, opts->server_pid, opts->answer);
+	opts->acked++;
+	stats_ack(opts->sent_ns[(opts->acked - 1) % WINDOW_MAX]);
+	return (1);
+}
+
+/**
+ * @brief Sends one payload frame within the send window.
+ *
+ * Up to `opts->window` frames may be waiting for acknowledgment, so the
+ * client does not stop after every signal. The first frame is sent alone:
+ * a `--fifo` server keeps it unacknowledged while the client waits for its
+ * turn, and only that first frame is stored in the admission queue.
+ * With `--stats`, the send time of the frame is kept until its
+ * acknowledgment, and the acknowledgments that arrived meanwhile are
+ * taken right after each send, so a round trip is not counted as lasting
+ * until the window was full.
+ *
+ * @param opts Client options (server PID, send window and frame counters).
+ * @param value Packed frame.
+ */
+void	send_window(t_options *opts, int value)
+{
+	long	sent;
+	int		taken;
+
+	sent = stats_clock();
+	opts->sent_ns[opts->frames % WINDOW_MAX] = sent;
+	send_frame(opts->server_pid, value);
+	opts->frames++;
+	taken = (sent != 0);
+	while (taken && opts->acked < opts->frames)
+		taken = wait_payload_ack(opts, 0);
+	while (opts->acked == 0 || opts->frames - opts->acked >= opts->window)
+		wait_payload_ack(opts, 1);
+}
+
+/**
+ * @brief Sends part of the message in payload frames, then the end frame.
+ *
+ * Each `sigqueue()` carries PAYLOAD_BYTES bytes, as cut by
+ * `encoder_next()`. The end of message frame (0 bytes) is sent outside the
+ * window, once every frame before it was acknowledged: it is answered
+ * with SIGUSR1, and no acknowledgment is left pending for the next
+ * message (see `--agent`).
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @param offset First byte of the message to send.
+ * @param len Number of bytes to send.
+ */
+void	send_range(t_options *opts, size_t offset, size_t len)
+{
+	t_encoder	enc;
+	t_record	rec;
+
+	encoder_start(&enc, opts->message + offset, len, ENCODE_FRAMES);
+	while (encoder_next(&enc, &rec))
+	{
+		if (!enc.last)
+			send_window(opts, rec.value);
+		while (enc.last && opts->acked < opts->frames)
+			wait_payload_ack(opts, 1);
+		if (enc.last)
+			send_frame(opts->server_pid, rec.value);
+	}
+}
+
+/**
+ * @brief Sends the whole message in payload frames, with a send window.
+ *
+ * The completion signal (SIGUSR1) is handled by `handle_completion()`.
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @return Always 1.
+ */
+int	send_payload(t_options *opts)
+{
+	send_range(opts, 0, ft_strlen(opts->message));
+	return (1);
+}
@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_pipe_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:20:35 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:14:28 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Writes the whole message to the pipe.
+ *
+ * @param fd Write end of the pipe, in blocking mode.
+ * @param msg Message to send.
+ * @param len Length of the message.
+ * @return 1 once every byte is written, 0 if the server closed the pipe.
+ */
+static int	pipe_write(int fd, const char *msg, size_t len)
+{
+	size_t	sent;
+	ssize_t	written;
+
+	sent = 0;
+	while (sent < len)
+	{
+		written = write(fd, msg + sent, len - sent);
+		if (written <= 0)
+			return (0);
+		sent += written;
+	}
+	return (1);
+}
+
+/**
+ * @brief Opens the named pipe the server created for this client.
+ *
+ * The pipe is only opened when the server answered PIPE_ACCEPTED, and
+ * only kept if it is a named pipe of this very user: the name is
+ * predictable, so anything else (a file planted by another user, a
+ * symbolic link) is left alone and the message goes another way.
+ *
+ * @param opts Client options (server PID and last answer).
+ * @return Write end of the pipe, or -1.
+ */
+static int	open_pipe(t_options *opts)
+{
+	struct stat	st;
+	char		*path;
+	int			fd;
+
+	if (opts->answer != PIPE_ACCEPTED)
+		return (-1);
+	path = pipe_path(opts->server_pid, getpid());
+	if (!path)
+		return (-1);
+	fd = open(path, O_WRONLY | O_NONBLOCK | O_NOFOLLOW);
+	free(path);
+	if (fd < 0)
+		return (-1);
+	if (fstat(fd, &st) == -1 || !S_ISFIFO(st.st_mode)
+		|| st.st_uid != geteuid())
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * @brief Sends the message through a named pipe created by the server.
+ *
+ * One FRAME_PIPE frame asks the server for the pipe (see `pipe_path()`);
+ * once it is accepted, the message goes out in large `write()` calls
+ * and the pipe is closed after the last byte. Signals are only used to
+ * set up the transfer and to confirm it. If the server refused the pipe,
+ * or it cannot be opened safely (see `open_pipe()`), another transport is
+ * used.
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @return 1 if the message went through the pipe, 0 otherwise.
+ */
+int	send_pipe(t_options *opts)
+{
+	int	fd;
+
+	send_window(opts, payload_header(FRAME_PIPE, 0));
+	while (opts->acked < opts->frames)
+		wait_payload_ack(opts, 1);
+	opts->features &= ~FEAT_PIPE;
+	fd = open_pipe(opts);
+	if (fd < 0)
+		return (0);
+	signal(SIGPIPE, SIG_IGN);
+	if (fcntl(fd, F_SETFL, 0) == -1
+		|| !pipe_write(fd, opts->message, ft_strlen(opts->message)))
+		ft_error();
+	close(fd);
+	return (1);
+}
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_pull_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:07:49 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:14:28 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Lets the server copy the message out of this process.
+ *
+ * Only the address and length of the message are sent, in payload frames;
+ * the server reads the message itself with `process_vm_readv()` and
+ * answers with SIGUSR1 alone, handled by `handle_completion()`.
+ *
+ * PR_SET_PTRACER grants the server the ptrace access it needs when Yama
+ * restricts it to ancestors (ptrace_scope 1); elsewhere it fails and is
+ * harmless. If the server still cannot read the message, it acknowledges
+ * the pull frame instead: the function then returns once every frame is
+ * acknowledged, and another transport is used.
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @return 0 (the pull failed); on success the process exits on SIGUSR1.
+ */
+int	send_pull(t_options *opts)
+{
+	unsigned long	addr;
+	size_t			len;
+
+	addr = (unsigned long)opts->message;
+	len = ft_strlen(opts->message);
+	prctl(PR_SET_PTRACER, opts->server_pid, 0, 0, 0);
+	send_window(opts, payload_header(FRAME_ADDR0, addr));
+	send_window(opts, payload_header(FRAME_ADDR1, addr >> 24));
+	send_window(opts, payload_header(FRAME_ADDR2, addr >> 48));
+	send_window(opts, payload_header(FRAME_LEN0, len));
+	send_window(opts, payload_header(FRAME_LEN1, len >> 24));
+	send_window(opts, payload_header(FRAME_PULL, 0));
+	while (opts->acked < opts->frames)
+		wait_payload_ack(opts, 1);
+	opts->features &= ~FEAT_PULL;
+	return (0);
+}
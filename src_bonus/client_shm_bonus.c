@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_shm_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:15:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:14:28 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Copies as many bytes as fit into the ring and publishes them.
+ *
+ * Only the contiguous room up to the end of the buffer is used; the next
+ * call wraps around.
+ *
+ * @param ring Shared ring.
+ * @param bytes Bytes to send.
+ * @param len Number of bytes.
+ * @return Number of bytes written (0 if the ring is full).
+ */
+static size_t	shm_write_some(t_shm_ring *ring, const char *bytes, size_t len)
+{
+	unsigned int	tail;
+	size_t			room;
+	size_t			index;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	room = SHM_RING_SIZE
+		- (tail - atomic_load_explicit(&ring->head, memory_order_acquire));
+	index = tail % SHM_RING_SIZE;
+	if (room > SHM_RING_SIZE - index)
+		room = SHM_RING_SIZE - index;
+	if (room > len)
+		room = len;
+	if (room == 0)
+		return (0);
+	ft_memcpy(ring->data + index, bytes, room);
+	atomic_store_explicit(&ring->tail, tail + room, memory_order_release);
+	atomic_fetch_add(&ring->seq, 1);
+	shm_wake(&ring->seq, &ring->server_asleep);
+	return (room);
+}
+
+/**
+ * @brief Streams the message through the ring.
+ *
+ * When the ring is full the client spins on `head` for a while, then
+ * sleeps on it until the server has made room. Every SHM_WAIT_NS asleep
+ * it checks that the server still exists, like the server does for the
+ * client, so a server that died does not leave it waiting forever.
+ *
+ * @param ring Shared ring.
+ * @param msg Message to send.
+ * @param len Length of the message.
+ * @param server PID of the server draining the ring.
+ * @return 1 once every byte is in the ring, 0 if the server gave up or
+ * exited.
+ */
+static int	shm_push(t_shm_ring *ring, const char *msg, size_t len,
+		pid_t server)
+{
+	size_t			sent;
+	size_t			written;
+	unsigned int	head;
+	int				spins;
+
+	sent = 0;
+	spins = 0;
+	while (sent < len)
+	{
+		if (atomic_load(&ring->aborted))
+			return (0);
+		head = atomic_load(&ring->head);
+		written = shm_write_some(ring, msg + sent, len - sent);
+		sent += written;
+		if (written > 0)
+			spins = 0;
+		else if (spins++ >= SHM_SPIN
+			&& shm_wait(&ring->head, head, &ring->client_asleep) == -1
+			&& kill(server, 0) == -1 && errno == ESRCH)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Sends the message through a shared-memory ring.
+ *
+ * The client creates its ring and asks the server to attach with one
+ * FRAME_SHM frame: the signal is only the rendezvous, the bytes never go
+ * through the kernel again. Once the server acknowledges, the name of the
+ * segment is removed (both sides keep their mapping). If the server did
+ * not attach another transport is used; otherwise the ring is closed
+ * after the last byte and the server answers with SIGUSR1.
+ *
+ * @param opts Client options (server PID and message).
+ * @return 1 if the message went through the ring, 0 otherwise.
+ */
+int	send_shm(t_options *opts)
+{
+	t_shm_ring	*ring;
+
+	ring = shm_map(getpid(), 1);
+	if (!ring)
+		return (0);
+	send_window(opts, payload_header(FRAME_SHM, 0));
+	while (opts->acked < opts->frames)
+		wait_payload_ack(opts, 1);
+	shm_unlink_ring(getpid());
+	opts->features &= ~FEAT_SHM;
+	if (!atomic_load(&ring->attached))
+	{
+		munmap(ring, sizeof(t_shm_ring));
+		return (0);
+	}
+	if (!shm_push(ring, opts->message, ft_strlen(opts->message),
+			opts->server_pid))
+		ft_error();
+	atomic_store(&ring->closed, 1);
+	atomic_fetch_add(&ring->seq, 1);
+	shm_wake(&ring->seq, &ring->server_asleep);
+	return (1);
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_stats_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:54:22 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static t_stats	*g_stats;
+
+/**
+ * @brief Starts collecting transfer statistics (`--stats`).
+ *
+ * The counters live in an anonymous shared mapping, so the stripe workers
+ * forked later add to the same ones. Without `--stats` this is never
+ * called and every other `stats_*()` function does nothing. The kernel
+ * cost of the client and of the server is taken now, so that the report
+ * shows what the transfer added (see `cost_open()`).
+ *
+ * @param server PID of the server process.
+ */
+void	stats_start(pid_t server)
+{
+	g_stats = mmap(NULL, sizeof(t_stats), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (g_stats == MAP_FAILED)
+	{
+		g_stats = NULL;
+		ft_error();
+	}
+	cost_open(&g_stats->client, 0, 0);
+	cost_sample(&g_stats->client);
+	cost_open(&g_stats->server, server, 0);
+	cost_sample(&g_stats->server);
+	g_stats->start_ns = stats_clock();
+}
+
+/**
+ * @brief Returns the monotonic time in nanoseconds.
+ *
+ * @return The time, or 0 when statistics are not collected (so that the
+ * send paths do not read the clock for nothing).
+ */
+long	stats_clock(void)
+{
+	struct timespec	now;
+
+	if (!g_stats)
+		return (0);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000000L + now.tv_nsec);
+}
+
+/**
+ * @brief Adds message bytes and signals to the statistics.
+ *
+ * @param bytes Message bytes handed to a transport.
+ * @param signals Signals queued to the server.
+ * @param retransmits How many of them repeat an unacknowledged one.
+ */
+void	stats_count(size_t bytes, int signals, int retransmits)
+{
+	if (!g_stats)
+		return ;
+	atomic_fetch_add(&g_stats->bytes, bytes);
+	atomic_fetch_add(&g_stats->signals, signals);
+	atomic_fetch_add(&g_stats->retransmits, retransmits);
+}
+
+/**
+ * @brief Records the round-trip time of one acknowledged signal.
+ *
+ * Every time is kept, in a histogram shared by the stripe workers (see
+ * `ft_hist_record()`).
+ *
+ * @param sent_ns Time the signal was sent (see `stats_clock()`).
+ */
+void	stats_ack(long sent_ns)
+{
+	if (!g_stats || sent_ns == 0)
+		return ;
+	ft_hist_record(&g_stats->rtt, stats_clock() - sent_ns);
+}
+
+/**
+ * @brief Prints the statistics collected so far on standard output.
+ *
+ * Called once the server confirmed the message (or each batch of the
+ * agent), after the completion line.
+ */
+void	stats_report(void)
+{
+	if (g_stats)
+		stats_print(g_stats, stats_clock());
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_stats_report_bonus.c                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:54:22 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Prints the round-trip time percentiles.
+ *
+ * Percentiles come from the histogram of `stats_ack()`, within
+ * 1/2^FT_HIST_SUB_BITS of the exact ones (see `ft_hist_percentile()`);
+ * the maximum is exact.
+ *
+ * @param stats Statistics to print.
+ */
+static void	print_rtt(t_stats *stats)
+{
+	t_hist	*rtt;
+
+	rtt = &stats->rtt;
+	if (atomic_load(&rtt->count) == 0)
+	{
+		ft_printf("RTT: no acknowledgment\n");
+		return ;
+	}
+	ft_printf("RTT: p50 %u ns, p90 %u ns, p99 %u ns, p99.9 %u ns, ",
+		(unsigned int)ft_hist_percentile(rtt, 5000),
+		(unsigned int)ft_hist_percentile(rtt, 9000),
+		(unsigned int)ft_hist_percentile(rtt, 9900),
+		(unsigned int)ft_hist_percentile(rtt, 9990));
+	ft_printf("max %u ns (%u acknowledgments)\n",
+		(unsigned int)ft_hist_percentile(rtt, 10000),
+		(unsigned int)atomic_load(&rtt->count));
+}
+
+/**
+ * @brief Prints what the transfer cost one process in the kernel and CPU.
+ *
+ * The counts are those taken since `stats_start()`. Those of the server
+ * include whatever it did for other clients meanwhile, and its context
+ * switches are those of its main thread (see `cost_sample()`).
+ *
+ * @param who "Client" or "Server".
+ * @param start Cost of the process when statistics started.
+ * @param bytes Message bytes sent so far.
+ */
+static void	print_cost(const char *who, t_cost *start, unsigned long bytes)
+{
+	t_cost	now;
+
+	now = *start;
+	cost_sample(&now);
+	bytes += (bytes == 0);
+	ft_printf("%s: %u voluntary and %u involuntary context switches, "
+		"%u minor faults\n", who, (unsigned int)(now.nvcsw - start->nvcsw),
+		(unsigned int)(now.nivcsw - start->nivcsw),
+		(unsigned int)(now.minflt - start->minflt));
+	if (now.cycles < 0 || now.instructions < 0)
+	{
+		ft_printf("%s: cycles and instructions not available\n", who);
+		return ;
+	}
+	ft_printf("%s: %u cycles and %u instructions per byte", who,
+		(unsigned int)((now.cycles - start->cycles) / bytes),
+		(unsigned int)((now.instructions - start->instructions) / bytes));
+	if (now.user_only)
+		ft_printf(" (user space only)");
+	ft_printf("\n");
+}
+
+/**
+ * @brief Prints the transfer statistics (`--stats`).
+ *
+ * Elapsed time runs from `stats_start()`, before the handshake, to `now_ns`;
+ * throughput is message bytes over that time. The kernel cost of both
+ * processes follows (see `print_cost()`).
+ *
+ * @param stats Statistics to print.
+ * @param now_ns Current time (see `stats_clock()`).
+ */
+void	stats_print(t_stats *stats, long now_ns)
+{
+	unsigned long	bytes;
+	long			elapsed;
+
+	bytes = atomic_load(&stats->bytes);
+	elapsed = now_ns - stats->start_ns;
+	if (elapsed < 1)
+		elapsed = 1;
+	ft_printf("Bytes sent: %u\n", (unsigned int)bytes);
+	ft_printf("Signals sent: %u (%u retransmitted)\n",
+		(unsigned int)atomic_load(&stats->signals),
+		(unsigned int)atomic_load(&stats->retransmits));
+	ft_printf("Elapsed: %u us\n", (unsigned int)(elapsed / 1000));
+	ft_printf("Throughput: %u bytes/s\n",
+		(unsigned int)(bytes * 1000000000.0 / elapsed));
+	print_rtt(stats);
+	print_cost("Client", &stats->client, bytes);
+	print_cost("Server", &stats->server, bytes);
+}
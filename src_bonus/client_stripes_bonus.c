@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_stripes_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:59:29 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:36:22 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+#include <sys/wait.h>
+
+/**
+ * @brief Worker side: sends the header of a stripe.
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @param group PID of the parent client, shared by all the workers.
+ * @param stripe Stripe index, and number of stripes in bits 8 to 15.
+ * @param start Offset of the stripe in the message.
+ */
+static void	send_header(t_options *opts, pid_t group, int stripe,
+		size_t start)
+{
+	send_window(opts, payload_header(FRAME_GROUP, group));
+	send_window(opts, payload_header(FRAME_STRIPE, stripe));
+	send_window(opts, payload_header(FRAME_OFFSET, start));
+	send_window(opts, payload_header(FRAME_TOTAL, ft_strlen(opts->message)));
+}
+
+/**
+ * @brief Worker side: sends one stripe of the message and exits.
+ *
+ * The stripe header (see `send_header()`) goes first, then the bytes of
+ * the stripe, through the same windowed frames as `send_payload()`.
+ * SIGUSR1 and SIGUSR2 are blocked before the end frame and consumed here,
+ * so only the parent reports completion. The server answers SIGUSR2 when
+ * it refuses the stripe (no free reassembly slot, or a stripe that does
+ * not match its group); the worker then exits with status 1. With
+ * `--trace` each worker writes a trace of its own.
+ *
+ * @param opts Client options (server PID, message and send window).
+ * @param group PID of the parent client, shared by all the workers.
+ * @param index Stripe sent by this worker.
+ * @param count Number of stripes.
+ */
+static void	send_stripe(t_options *opts, pid_t group, int index, int count)
+{
+	sigset_t	done;
+	size_t		len;
+	size_t		start;
+	size_t		end;
+	int			sig;
+
+	if (opts->trace)
+		trace_start("client stripe");
+	sigemptyset(&done);
+	sigaddset(&done, SIGUSR1);
+	sigaddset(&done, SIGUSR2);
+	sigprocmask(SIG_BLOCK, &done, NULL);
+	len = ft_strlen(opts->message);
+	start = len * index / count;
+	end = len * (index + 1) / count;
+	opts->frames = 0;
+	opts->acked = 0;
+	send_header(opts, group, index | count << 8, start);
+	send_range(opts, start, end - start);
+	sig = sigwaitinfo(&done, NULL);
+	while (sig != SIGUSR1 && sig != SIGUSR2)
+		sig = sigwaitinfo(&done, NULL);
+	exit(sig != SIGUSR1);
+}
+
+/**
+ * @brief Waits for every worker.
+ *
+ * @param count Number of workers still running.
+ * @return 1 if every stripe was confirmed, 0 if one was refused or its
+ * worker failed.
+ */
+static int	wait_workers(int count)
+{
+	int	status;
+	int	failed;
+
+	failed = 0;
+	while (count > 0)
+	{
+		if (wait(&status) == -1)
+			break ;
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			failed = 1;
+		count--;
+	}
+	return (!failed);
+}
+
+/**
+ * @brief Sends the message in stripes from several worker processes.
+ *
+ * One sender is bound by its own signal round trip, so the message is cut
+ * into `opts->stripes` contiguous stripes and a forked worker sends each
+ * one in parallel, under its own PID (and its own server session). The
+ * server puts the stripes back in order and prints the message once.
+ *
+ * Without `--stripes`, or for messages too short to split (fewer bytes than
+ * stripes), the function returns 0 and another transport is used. It also
+ * returns 0 once the workers are done if the server refused a stripe or a
+ * worker failed: the server has dropped the partial message, so it is sent
+ * again without stripes. Otherwise it does not return: the client exits.
+ *
+ * @param opts Client options (server PID, message, window and stripes).
+ * @return 0 if the message was not delivered in stripes.
+ */
+int	send_stripes(t_options *opts)
+{
+	size_t	len;
+	pid_t	group;
+	pid_t	worker;
+	int		i;
+
+	len = ft_strlen(opts->message);
+	if (opts->stripes < 2 || len < (size_t)opts->stripes)
+		return (0);
+	group = getpid();
+	i = 0;
+	while (i < opts->stripes)
+	{
+		worker = fork();
+		if (worker == -1)
+			ft_error();
+		if (worker == 0)
+			send_stripe(opts, group, i, opts->stripes);
+		i++;
+	}
+	if (!wait_workers(opts->stripes))
+		return (0);
+	ft_printf("\nMessage received by server!\n");
+	stats_report();
+	exit(0);
+}
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   client_transport_bonus.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:17:26 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:50:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Gives up if the server turned this client away.
+ *
+ * A `--fifo` server whose admission queue is full answers the first signal
+ * of a new client with the value QUEUE_BUSY instead of leaving it waiting
+ * for a turn that would never come (see `admit_client()`).
+ *
+ * @param answer Value queued with an acknowledgment.
+ */
+void	server_busy(int answer)
+{
+	if (answer != QUEUE_BUSY)
+		return ;
+	ft_putendl_fd("Error: server busy (admission queue full)", 2);
+	exit(1);
+}
+
+/**
+ * @brief Sends the message one symbol at a time, with its terminator.
+ *
+ * The symbols come from `encoder_next()`: real-time alphabet symbols or
+ * single bits, depending on the negotiated features, each with its marker.
+ * Each one is sent and acknowledged by `send_symbol()`.
+ *
+ * @param opts Client options (server PID, message and features).
+ * @return Always 1.
+ */
+static int	send_chars(t_options *opts)
+{
+	t_encoder	enc;
+	t_record	rec;
+	int			mode;
+
+	mode = ENCODE_BITS;
+	if (opts->features & FEAT_ALPHABET)
+		mode = ENCODE_ALPHABET;
+	encoder_start(&enc, opts->message, ft_strlen(opts->message), mode);
+	while (encoder_next(&enc, &rec))
+		send_symbol(opts->server_pid, rec.sig, rec.value);
+	return (1);
+}
+
+/**
+ * @brief Transports, from the preferred one to the last resort.
+ *
+ * A transport is used if its feature was negotiated and the message size
+ * is within its range. Bulk transports have a fixed setup cost (a syscall
+ * or a mapping, a fork) and only pay off above their minimum size; the
+ * signal transports work for any message and any server.
+ */
+static const t_transport	g_transports[TRANSPORT_COUNT] = {
+{"pull", FEAT_PULL, PULL_MIN_SIZE, PULL_MAX_SIZE, send_pull},
+{"shm", FEAT_SHM, SHM_MIN_SIZE, (size_t)-1, send_shm},
+{"pipe", FEAT_PIPE, PIPE_MIN_SIZE, (size_t)-1, send_pipe},
+{"stripes", FEAT_STRIPES, 2, STRIPE_MAX_SIZE, send_stripes},
+{"frames", FEAT_PAYLOAD, 0, (size_t)-1, send_payload},
+{"signals", 0, 0, (size_t)-1, send_chars}
+};
+
+/**
+ * @brief Sends the message with the best transport of the session.
+ *
+ * All transports share the same session, opened by `negotiate()`, and the
+ * same completion signal (SIGUSR1, handled by `handle_completion()`). A
+ * transport that turns out to be unusable (e.g. the server cannot read
+ * this process, or cannot attach to its ring) returns 0 and the next one
+ * is tried, down to the signal transports that always work.
+ *
+ * @param opts Client options (server PID, message and features).
+ */
+void	send_message(t_options *opts)
+{
+	const t_transport	*transport;
+	size_t				len;
+	int					i;
+
+	len = ft_strlen(opts->message);
+	stats_count(len, 0, 0);
+	i = 0;
+	while (i < TRANSPORT_COUNT)
+	{
+		transport = &g_transports[i];
+		if ((opts->features & transport->feature) == transport->feature
+			&& len >= transport->min_size && len <= transport->max_size
+			&& transport->send(opts))
+			return ;
+		i++;
+	}
+}
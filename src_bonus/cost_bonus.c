@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cost_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:11:44 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Opens one hardware counter of a process.
+ *
+ * The counter follows the threads and children the process creates after
+ * it is opened (`inherit`), whose counts are added when they exit.
+ *
+ * @param pid Process to count (0 for this one).
+ * @param config PERF_COUNT_HW_CPU_CYCLES or PERF_COUNT_HW_INSTRUCTIONS.
+ * @param on_exec 1 to start counting at the next `execve()` of the process.
+ * @param user_only 1 to leave the kernel out.
+ * @return The counter, or -1 if it cannot be opened.
+ */
+static int	perf_open(pid_t pid, unsigned long config, int on_exec,
+		int user_only)
+{
+	struct perf_event_attr	attr;
+
+	ft_bzero(&attr, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.inherit = 1;
+	attr.exclude_hv = 1;
+	attr.exclude_kernel = user_only;
+	attr.disabled = on_exec;
+	attr.enable_on_exec = on_exec;
+	return (syscall(SYS_perf_event_open, &attr, pid, -1, -1,
+			PERF_FLAG_FD_CLOEXEC));
+}
+
+/**
+ * @brief Starts counting the cycles and instructions of a process.
+ *
+ * Kernel and user space are counted together when allowed: the signal
+ * protocols spend most of their time in the kernel. With a
+ * kernel.perf_event_paranoid of 2 only user space may be counted, and
+ * without hardware counters (e.g. in some virtual machines) nothing is.
+ *
+ * @param cost Cost to fill (zeroed first, counts start at 0).
+ * @param pid Process to count (0 for this one).
+ * @param on_exec 1 to start counting at the next `execve()` of the process.
+ */
+void	cost_open(t_cost *cost, pid_t pid, int on_exec)
+{
+	ft_bzero(cost, sizeof(t_cost));
+	cost->pid = pid;
+	cost->cycles = -1;
+	cost->instructions = -1;
+	cost->perf[0] = perf_open(pid, PERF_COUNT_HW_CPU_CYCLES, on_exec, 0);
+	if (cost->perf[0] < 0)
+	{
+		cost->user_only = 1;
+		cost->perf[0] = perf_open(pid, PERF_COUNT_HW_CPU_CYCLES, on_exec, 1);
+	}
+	cost->perf[1] = perf_open(pid, PERF_COUNT_HW_INSTRUCTIONS, on_exec,
+			cost->user_only);
+}
+
+/**
+ * @brief Reads the cycles and instructions counted so far.
+ *
+ * A counter that cannot be read is left at -1.
+ *
+ * @param cost Cost opened by `cost_open()`.
+ */
+void	cost_read(t_cost *cost)
+{
+	long	count;
+
+	if (cost->perf[0] >= 0
+		&& read(cost->perf[0], &count, sizeof(count)) == sizeof(count))
+		cost->cycles = count;
+	if (cost->perf[1] >= 0
+		&& read(cost->perf[1], &count, sizeof(count)) == sizeof(count))
+		cost->instructions = count;
+}
+
+/**
+ * @brief Takes the context switches and page faults of a resource usage.
+ *
+ * @param cost Cost to update.
+ * @param usage Usage from `getrusage()` or `wait4()`.
+ */
+void	cost_usage(t_cost *cost, struct rusage *usage)
+{
+	cost->nvcsw = usage->ru_nvcsw;
+	cost->nivcsw = usage->ru_nivcsw;
+	cost->minflt = usage->ru_minflt;
+}
+
+/**
+ * @brief Closes the counters of a cost (its values are kept).
+ *
+ * @param cost Cost opened by `cost_open()`.
+ */
+void	cost_close(t_cost *cost)
+{
+	if (cost->perf[0] >= 0)
+		close(cost->perf[0]);
+	if (cost->perf[1] >= 0)
+		close(cost->perf[1]);
+	cost->perf[0] = -1;
+	cost->perf[1] = -1;
+}
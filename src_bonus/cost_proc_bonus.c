@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cost_proc_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:11:59 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:04 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Reads a file of /proc/<pid>/, NUL-terminated.
+ *
+ * The path is built on the stack, as `stats_report()` may run from a
+ * signal handler.
+ *
+ * @param pid Process.
+ * @param file File name ("stat" or "status").
+ * @param buf Buffer receiving the contents.
+ * @param size Size of `buf`.
+ * @return 1 if something was read, 0 otherwise.
+ */
+static int	proc_read(pid_t pid, const char *file, char *buf, size_t size)
+{
+	char	path[64];
+	ssize_t	len;
+	int		fd;
+	int		i;
+
+	i = 24;
+	path[i] = '\0';
+	while (pid > 0 || i == 24)
+	{
+		path[--i] = '0' + pid % 10;
+		pid /= 10;
+	}
+	i -= 6;
+	ft_memcpy(path + i, "/proc/", 6);
+	ft_strlcpy(path + 24, "/", 2);
+	ft_strlcat(path + 24, file, sizeof(path) - 24);
+	fd = open(path + i, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return (0);
+	len = read(fd, buf, size - 1);
+	close(fd);
+	if (len <= 0)
+		return (0);
+	buf[len] = '\0';
+	return (1);
+}
+
+/**
+ * @brief Returns the number that follows a key in a /proc file.
+ *
+ * @param text Contents of the file.
+ * @param key Key, with the newline before it so that it matches whole.
+ * @return The number, or 0 if the key is missing.
+ */
+static long	proc_field(const char *text, const char *key)
+{
+	const char	*found;
+
+	found = ft_strnstr(text, key, ft_strlen(text));
+	if (!found)
+		return (0);
+	return (ft_atol(found + ft_strlen(key)));
+}
+
+/**
+ * @brief Takes the minor faults and context switches of another process.
+ *
+ * Minor faults come from /proc/<pid>/stat (10th field, summed over the
+ * threads); context switches from /proc/<pid>/status, which only has
+ * those of the main thread.
+ *
+ * @param cost Cost of the process, updated.
+ */
+static void	proc_usage(t_cost *cost)
+{
+	char	buf[4096];
+	char	*field;
+	int		skip;
+
+	if (proc_read(cost->pid, "stat", buf, sizeof(buf)))
+	{
+		field = ft_strrchr(buf, ')');
+		skip = 0;
+		while (field && skip++ < 8)
+			field = ft_strchr(field + 1, ' ');
+		if (field)
+			cost->minflt = ft_atol(field);
+	}
+	if (proc_read(cost->pid, "status", buf, sizeof(buf)))
+	{
+		cost->nvcsw = proc_field(buf, "\nvoluntary_ctxt_switches:");
+		cost->nivcsw = proc_field(buf, "\nnonvoluntary_ctxt_switches:");
+	}
+}
+
+/**
+ * @brief Takes the current cost of a process.
+ *
+ * For this process (`pid` 0) the usage of its children is added, so the
+ * stripe workers are counted once they have been waited for.
+ *
+ * @param cost Cost opened by `cost_open()`, updated.
+ */
+void	cost_sample(t_cost *cost)
+{
+	struct rusage	self;
+	struct rusage	children;
+
+	if (cost->pid == 0 && getrusage(RUSAGE_SELF, &self) == 0
+		&& getrusage(RUSAGE_CHILDREN, &children) == 0)
+	{
+		self.ru_nvcsw += children.ru_nvcsw;
+		self.ru_nivcsw += children.ru_nivcsw;
+		self.ru_minflt += children.ru_minflt;
+		cost_usage(cost, &self);
+	}
+	else if (cost->pid > 0)
+		proc_usage(cost);
+	cost_read(cost);
+}
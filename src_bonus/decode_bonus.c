@@ -0,0 +1,181 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   decode_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:53:01 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:41 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Accumulates one symbol of the bit or alphabet protocols.
+ *
+ * Each signal carries one symbol of a character, LSB first:
+ * - SIGUSR1 → bit 0
+ * - SIGUSR2 → bit 1
+ * - SIGRTMIN + n → the `ALPHABET_BITS` bits of n (see `signal_symbol()`)
+ *
+ * Once 8 bits are received, a full character is reconstructed. The '\0'
+ * character terminates the message; any other character is appended to the
+ * session buffer. If the buffer cannot grow, the symbol is taken back, so
+ * the decoder is left as it was before it and the unacknowledged symbol,
+ * once sent again, is decoded on a consistent state.
+ *
+ * @param session Session of the sender.
+ * @param sig Received signal.
+ * @return FEED_ACK, FEED_DONE or FEED_DROP.
+ */
+static int	feed_symbol(t_session *session, int sig)
+{
+	int	value;
+	int	bits;
+
+	bits = signal_symbol(sig, &value);
+	if (bits == 0)
+		return (FEED_DROP);
+	session->current |= (value << session->bit_count);
+	session->bit_count += bits;
+	if (session->bit_count < 8)
+		return (FEED_ACK);
+	session->bit_count = 0;
+	if (session->current == '\0')
+		return (FEED_DONE);
+	if (!session_append(session, (char *)&session->current, 1))
+	{
+		session->bit_count = 8 - bits;
+		session->current &= (1 << session->bit_count) - 1;
+		return (FEED_DROP);
+	}
+	session->current = 0;
+	return (FEED_ACK);
+}
+
+/**
+ * @brief Stores one stripe header field in the session.
+ *
+ * @param session Session of the worker sending the stripe.
+ * @param kind Kind of the frame (see `payload_kind()`).
+ * @param field 24-bit field of the frame.
+ * @return FEED_ACK, or FEED_DROP for an unknown kind.
+ */
+static int	feed_header(t_session *session, int kind, size_t field)
+{
+	if (kind == FRAME_GROUP)
+		session->stripe.group = field;
+	else if (kind == FRAME_STRIPE)
+	{
+		session->stripe.index = field & 0xFF;
+		session->stripe.count = (field >> 8) & 0xFF;
+	}
+	else if (kind == FRAME_OFFSET)
+		session->stripe.offset = field;
+	else if (kind == FRAME_TOTAL)
+		session->stripe.total = field;
+	else
+		return (FEED_DROP);
+	return (FEED_ACK);
+}
+
+/**
+ * @brief Stores one field of a pull request in the session.
+ *
+ * FRAME_ADDR0 starts a new request. FRAME_PULL closes it; the copy itself
+ * is left to the caller (see `session_pull()`), as is attaching to the
+ * shared-memory ring requested by FRAME_SHM (see `shm_start()`) and
+ * creating the named pipe requested by FRAME_PIPE (see `pipe_start()`).
+ *
+ * @param session Session of the sender.
+ * @param kind Kind of the frame (see `payload_kind()`).
+ * @param field 24-bit field of the frame.
+ * @return FEED_ACK, FEED_PULL, FEED_SHM, FEED_PIPE, or FEED_DROP for an
+ * unknown kind.
+ */
+static int	feed_pull(t_session *session, int kind, unsigned long field)
+{
+	if (kind == FRAME_ADDR0)
+		session->pull_addr = field;
+	else if (kind == FRAME_ADDR1)
+		session->pull_addr |= field << 24;
+	else if (kind == FRAME_ADDR2)
+		session->pull_addr |= field << 48;
+	else if (kind == FRAME_LEN0)
+		session->pull_len = field;
+	else if (kind == FRAME_LEN1)
+		session->pull_len |= field << 24;
+	else if (kind == FRAME_PULL)
+		return (FEED_PULL);
+	else if (kind == FRAME_SHM)
+		return (FEED_SHM);
+	else if (kind == FRAME_PIPE)
+		return (FEED_PIPE);
+	else
+		return (FEED_DROP);
+	return (FEED_ACK);
+}
+
+/**
+ * @brief Appends the bytes of one payload frame.
+ *
+ * Header frames of a striped transfer are stored by `feed_header()` and
+ * pull requests by `feed_pull()`; data frames go to the session buffer as
+ * for any other message.
+ *
+ * @param session Session of the sender.
+ * @param value Packed frame (see `payload_pack()`).
+ * @return FEED_ACK, FEED_DONE (empty frame), FEED_PULL or FEED_DROP.
+ */
+static int	feed_payload(t_session *session, int value)
+{
+	char	bytes[PAYLOAD_BYTES];
+	int		count;
+
+	if (payload_kind(value) >= FRAME_ADDR0)
+		return (feed_pull(session, payload_kind(value), value & 0xFFFFFF));
+	if (payload_kind(value) != FRAME_DATA)
+		return (feed_header(session, payload_kind(value), value & 0xFFFFFF));
+	count = payload_unpack(value, bytes);
+	if (count == 0)
+		return (FEED_DONE);
+	if (!session_append(session, bytes, count))
+		return (FEED_DROP);
+	return (FEED_ACK);
+}
+
+/**
+ * @brief Feeds one received signal to the decoder of a session.
+ *
+ * This is the whole receive state machine: it only updates the session and
+ * reports what happened. Acknowledging, writing and releasing the session
+ * are left to the caller, so the decoder can be driven by something other
+ * than real signals.
+ *
+ * A symbol queued with the same marker as the previous one is a resend of
+ * a symbol already decoded (its acknowledgment was late or lost): it is
+ * acknowledged again but not decoded twice. The marker of a symbol the
+ * decoder refused is not kept, so its resend is decoded. Symbols sent with
+ * `kill()`, as the mandatory client does, have no marker (0).
+ *
+ * @param session Session of the sender.
+ * @param sig Received signal.
+ * @param value Value queued with the signal (packed frame, or marker of a
+ * symbol).
+ * @return FEED_ACK, FEED_DONE, FEED_PULL or FEED_DROP.
+ */
+int	session_feed(t_session *session, int sig, int value)
+{
+	int	status;
+
+	if (sig == SIG_PAYLOAD)
+		return (feed_payload(session, value));
+	if (value != 0 && value == session->marker)
+		return (FEED_ACK);
+	status = feed_symbol(session, sig);
+	if (status != FEED_DROP)
+		session->marker = value;
+	return (status);
+}
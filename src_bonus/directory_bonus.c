@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   directory_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:05:41 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:07:42 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Builds a name made of a prefix, a PID and a suffix.
+ *
+ * Used for every file a server or client shares by PID, such as the worker
+ * directory ("/tmp/minitalk.<master>.workers").
+ *
+ * @param prefix Text before the PID.
+ * @param pid PID the name belongs to.
+ * @param suffix Text after the PID.
+ * @return The name (to free), or NULL.
+ */
+char	*pid_path(const char *prefix, pid_t pid, const char *suffix)
+{
+	char	*number;
+	char	*head;
+	char	*path;
+
+	number = ft_itoa(pid);
+	if (!number)
+		return (NULL);
+	head = ft_strjoin(prefix, number);
+	free(number);
+	if (!head)
+		return (NULL);
+	path = ft_strjoin(head, suffix);
+	free(head);
+	return (path);
+}
+
+/**
+ * @brief Builds the name of the named pipe of one client (`--pipe`).
+ *
+ * @param server PID of the server that reads the pipe.
+ * @param client PID of the client that writes to it.
+ * @return DIRECTORY_PREFIX<server>.pipes/<client> (to free), or NULL.
+ */
+char	*pipe_path(pid_t server, pid_t client)
+{
+	char	*head;
+	char	*path;
+
+	head = pid_path(DIRECTORY_PREFIX, server, ".pipes/");
+	if (!head)
+		return (NULL);
+	path = pid_path(head, client, "");
+	free(head);
+	return (path);
+}
+
+/**
+ * @brief Master side: publishes the PIDs of the workers.
+ *
+ * The list is written to a temporary file renamed over the directory, so
+ * a client never reads a partial list. The file is created private to this
+ * user (see `create_private()`), so a link planted at its predictable name
+ * is never followed.
+ *
+ * @param path Directory path (see `pid_path()`).
+ * @param pids Worker PIDs.
+ * @param count Number of workers.
+ * @return 1 on success, 0 on failure.
+ */
+int	directory_publish(const char *path, pid_t *pids, int count)
+{
+	char	*tmp;
+	int		fd;
+	int		i;
+
+	tmp = ft_strjoin(path, ".tmp");
+	if (!tmp)
+		return (0);
+	fd = create_private(tmp);
+	i = 0;
+	while (fd >= 0 && i < count)
+	{
+		ft_putnbr_fd(pids[i], fd);
+		ft_putchar_fd('\n', fd);
+		i++;
+	}
+	if (fd >= 0)
+		close(fd);
+	i = (fd >= 0 && rename(tmp, path) == 0);
+	free(tmp);
+	return (i);
+}
+
+/**
+ * @brief Reads the PIDs of the workers a master published.
+ *
+ * The directory is only read if this user wrote it (see `open_private()`):
+ * its name is predictable, and another user could otherwise point clients
+ * at processes of their choosing.
+ *
+ * @param master PID of the master server.
+ * @param pids Receives up to WORKERS_MAX PIDs.
+ * @return Number of PIDs read (0 without a trusted directory).
+ */
+int	directory_read(pid_t master, pid_t *pids)
+{
+	char	*path;
+	char	*line;
+	int		count;
+	int		fd;
+
+	path = pid_path(DIRECTORY_PREFIX, master, ".workers");
+	fd = -1;
+	if (path)
+		fd = open_private(path);
+	free(path);
+	count = 0;
+	line = NULL;
+	if (fd >= 0)
+		line = get_next_line(fd);
+	while (line)
+	{
+		if (count < WORKERS_MAX)
+			pids[count++] = ft_atoi(line);
+		free(line);
+		line = get_next_line(fd);
+	}
+	if (fd >= 0)
+		close(fd);
+	return (count);
+}
+
+/**
+ * @brief Client side: replaces the server PID with one of its workers.
+ *
+ * If the server published a worker directory, the client picks the worker
+ * at its own PID modulo the number of workers: consecutive clients spread
+ * evenly over the pool, and a striped transfer (resolved once, before its
+ * workers are forked) stays on one server process. Without a directory,
+ * or if the chosen worker is gone, the PID is left unchanged and the
+ * master serves the client itself.
+ *
+ * @param opts Client options (`server_pid` may be updated).
+ */
+void	directory_lookup(t_options *opts)
+{
+	pid_t	pids[WORKERS_MAX];
+	int		count;
+
+	count = directory_read(opts->server_pid, pids);
+	if (count > 0 && kill(pids[getpid() % count], 0) == 0)
+		opts->server_pid = pids[getpid() % count];
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dispatch_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:54:49 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:50:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Completes a message: prints it and notifies the client.
+ *
+ * The message is written in one go and SIGUSR1 confirms completion to the
+ * client once `write()` has returned (see `output_chunk()`). The session is
+ * released, except for the negotiated features of a client that asked to
+ * keep it (FEAT_KEEP), which sends its next message without a new
+ * handshake. In threaded mode the message is handed to the writer thread
+ * instead, which writes and confirms it, so the decoder can go on with the
+ * next record right away. In FIFO mode the next waiting client
+ * is then admitted and its pending first signal is handled, which also
+ * sends the acknowledgment it has been waiting for.
+ *
+ * @param server Server state.
+ * @param session Session whose message is complete.
+ */
+static void	finish_message(t_server *server, t_session *session)
+{
+	t_record	next;
+	t_chunk		chunk;
+	pid_t		pid;
+	int			features;
+
+	session_take(session, &chunk);
+	metrics_message(session->pid, chunk.len);
+	if (server->shard)
+		pipeline_emit(server, &chunk);
+	else
+		output_chunk(server, &chunk);
+	pid = session->pid;
+	features = session->features;
+	session_end(session);
+	if (features & FEAT_KEEP)
+	{
+		session->pid = pid;
+		session->features = features;
+	}
+	if (server->fifo && next_client(&server->queue, &server->active, &next))
+		handle_record(server, &next);
+}
+
+/**
+ * @brief Acknowledges one decoded symbol or frame.
+ *
+ * Payload frames are answered with SIG_PAYLOAD_ACK, symbols of the bit and
+ * alphabet protocols with SIGUSR2. Both are sent with `kill()`, which is
+ * never refused for a full signal queue, except the acknowledgment of a
+ * symbol that carries a marker, queued back with that marker, and the
+ * answer to an accepted named pipe, queued with the value PIPE_ACCEPTED
+ * (a plain `kill()` if that fails, which the client takes as an unmarked
+ * acknowledgment or a refusal). A signal the decoder refused is only
+ * counted (see `metrics_resync()`), as is a sender turned away because the
+ * admission queue is full (FEED_BUSY), which is also answered with
+ * QUEUE_BUSY if it reads queued values (a frame, or a marked symbol; the
+ * mandatory client could only take it for an acknowledgment).
+ * Acknowledgments are traced.
+ *
+ * @param rec Record being acknowledged.
+ * @param status Result of the decoder (see `session_feed()`).
+ */
+static void	acknowledge(t_record *rec, int status)
+{
+	union sigval	answer;
+	int				ack;
+
+	if (status == FEED_DROP || status == FEED_BUSY)
+		metrics_resync(0);
+	if (status == FEED_DROP || (status == FEED_BUSY
+			&& rec->sig != SIG_PAYLOAD && rec->value == 0))
+		return ;
+	ack = SIGUSR2;
+	if (rec->sig == SIG_PAYLOAD)
+		ack = SIG_PAYLOAD_ACK;
+	answer.sival_int = 0;
+	if (rec->sig != SIG_PAYLOAD)
+		answer.sival_int = rec->value;
+	if (status == FEED_ACCEPT)
+		answer.sival_int = PIPE_ACCEPTED;
+	if (status == FEED_BUSY)
+		answer.sival_int = QUEUE_BUSY;
+	if (answer.sival_int && sigqueue(rec->pid, ack, answer) == -1)
+		answer.sival_int = 0;
+	if (!answer.sival_int && status != FEED_BUSY)
+		kill(rec->pid, ack);
+	trace_mark(TRACE_ACK, ack, rec->pid, answer.sival_int);
+}
+
+/**
+ * @brief Decodes one data signal of an admitted client.
+ *
+ * Each decoded symbol or frame is acknowledged (see `acknowledge()`).
+ * Signals the decoder cannot use are left unacknowledged, so the client
+ * retries them. A pull request that succeeds completes the message; if the
+ * copy fails it is only acknowledged, which tells the client to send the
+ * message in frames instead. Shared-memory and named pipe requests are
+ * handed to `shm_start()` and `pipe_start()`.
+ *
+ * @param server Server state.
+ * @param rec Sender PID, signal number and queued value.
+ */
+static void	feed_record(t_server *server, t_record *rec)
+{
+	t_session	*session;
+	int			status;
+
+	session = session_get(server, rec->pid);
+	if (!session)
+		return ;
+	status = session_feed(session, rec->sig, rec->value);
+	if (status == FEED_PULL && session_pull(session))
+		status = FEED_DONE;
+	if (status == FEED_SHM)
+		status = shm_start(server, session);
+	if (status == FEED_PIPE)
+		status = pipe_start(server, session);
+	if (status == FEED_DONE)
+		finish_message(server, session);
+	else
+		acknowledge(rec, status);
+}
+
+/**
+ * @brief Handles one signal received from a client.
+ *
+ * SIG_HELLO starts a negotiated session and is answered right away, even
+ * for a client waiting in the FIFO queue. Any other signal is data: in FIFO
+ * mode only the client owning the session is decoded and other senders are
+ * queued by `admit_client()`, or turned away if the queue is full. Data is
+ * fed to the sender's own session (see `feed_record()`), so legacy (1-bit)
+ * and negotiated clients can be served concurrently.
+ * SIG_GONE records, from the event loop, release the session of a client
+ * that has exited (see `client_gone()`).
+ *
+ * @param server Server state.
+ * @param rec Sender PID, signal number and queued value.
+ */
+void	handle_record(t_server *server, t_record *rec)
+{
+	int	admitted;
+
+	if (rec->sig == SIG_HELLO)
+		answer_hello(server, rec);
+	else if (rec->sig == SIG_GONE)
+		client_gone(server, rec->pid);
+	if (rec->sig == SIG_HELLO || rec->sig == SIG_GONE)
+		return ;
+	admitted = 1;
+	if (server->fifo)
+		admitted = admit_client(&server->queue, &server->active, rec);
+	if (admitted < 0)
+		acknowledge(rec, FEED_BUSY);
+	if (admitted > 0)
+		feed_record(server, rec);
+}
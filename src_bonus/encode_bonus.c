@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   encode_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:20:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:48:48 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Produces the next payload frame, or the empty end frame.
+ *
+ * @param enc Encoder.
+ * @param out Receives SIG_PAYLOAD and the packed frame.
+ * @return Always 1.
+ */
+static int	next_frame(t_encoder *enc, t_record *out)
+{
+	size_t	count;
+
+	count = enc->len - enc->pos;
+	if (count > PAYLOAD_BYTES)
+		count = PAYLOAD_BYTES;
+	out->sig = SIG_PAYLOAD;
+	out->value = payload_pack(enc->message + enc->pos, count);
+	enc->pos += count;
+	enc->last = (count == 0);
+	return (1);
+}
+
+/**
+ * @brief Produces the next symbol of the current character, LSB first.
+ *
+ * Past the end of the message the character is the '\0' terminator.
+ *
+ * @param enc Encoder.
+ * @param out Receives SIGUSR1/SIGUSR2 for one bit, or SIGRTMIN + n for
+ * `ALPHABET_BITS` bits (see `symbol_signal()`).
+ * @return Always 1.
+ */
+static int	next_symbol(t_encoder *enc, t_record *out)
+{
+	unsigned char	chr;
+
+	chr = '\0';
+	if (enc->pos < enc->len)
+		chr = enc->message[enc->pos];
+	if (enc->mode == ENCODE_ALPHABET)
+	{
+		out->sig = symbol_signal((chr >> enc->bit) & (ALPHABET_SIZE - 1));
+		enc->bit += ALPHABET_BITS;
+	}
+	else
+	{
+		out->sig = SIGUSR1;
+		if ((chr >> enc->bit) & 1)
+			out->sig = SIGUSR2;
+		enc->bit++;
+	}
+	if (enc->bit < 8)
+		return (1);
+	enc->bit = 0;
+	enc->last = (enc->pos == enc->len);
+	enc->pos += !enc->last;
+	return (1);
+}
+
+/**
+ * @brief Starts encoding a message.
+ *
+ * @param enc Encoder to reset.
+ * @param message Bytes to send (the symbol encodings stop at a '\0').
+ * @param len Number of bytes.
+ * @param mode ENCODE_BITS, ENCODE_ALPHABET or ENCODE_FRAMES.
+ */
+void	encoder_start(t_encoder *enc, const char *message, size_t len,
+		int mode)
+{
+	enc->message = message;
+	enc->len = len;
+	enc->pos = 0;
+	enc->bit = 0;
+	enc->mode = mode;
+	enc->last = 0;
+	enc->marker = 0;
+}
+
+/**
+ * @brief Produces the next signal of the message.
+ *
+ * A symbol is queued with its marker, 1 and 2 in turn, so two consecutive
+ * symbols never carry the same one and a repeated symbol can be told from
+ * the next (see ACK_TIMEOUT_NS).
+ *
+ * @param enc Encoder (`last` is set when `out` is the terminator).
+ * @param out Receives the signal and its queued value (the packed frame,
+ * or the marker of a symbol).
+ * @return 1 if a signal was produced, 0 once the terminator was.
+ */
+int	encoder_next(t_encoder *enc, t_record *out)
+{
+	if (enc->last)
+		return (0);
+	out->pid = 0;
+	if (enc->mode == ENCODE_FRAMES)
+		return (next_frame(enc, out));
+	enc->marker = enc->marker % 2 + 1;
+	out->value = enc->marker;
+	return (next_symbol(enc, out));
+}
@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   event_loop_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:28:56 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:12:25 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Hands a record to the decoder of its client.
+ *
+ * In threaded mode this thread only routes records to the decoder threads
+ * (see `pipeline_route()`). Records are counted here, before decoding,
+ * so client rows are only ever taken and freed by this thread. With
+ * `--record` they are also logged here (see `record_signal()`), in the
+ * order the decoder sees them. Handling a record is traced as the server's
+ * signal handler (TRACE_HANDLER).
+ *
+ * @param server Server state.
+ * @param rec Record to handle.
+ */
+static void	dispatch(t_server *server, t_record *rec)
+{
+	record_signal(rec);
+	if (rec->sig == SIG_GONE)
+		metrics_gone(rec->pid);
+	else
+		metrics_signal(rec->pid);
+	if (server->pipeline)
+		pipeline_route(server->pipeline, rec);
+	else
+	{
+		trace_span(TRACE_HANDLER, 1);
+		handle_record(server, rec);
+		trace_span(TRACE_HANDLER, 0);
+	}
+}
+
+/**
+ * @brief Starts watching a client with a pidfd, unless already watched.
+ *
+ * A client that cannot be watched (full table, or a kernel without
+ * `pidfd_open()`) is served as before, without exit tracking.
+ *
+ * @param watch Event loop descriptors.
+ * @param pid PID of the client.
+ * @return 0 if the client has already exited, 1 otherwise.
+ */
+static int	watch_client(t_watch *watch, pid_t pid)
+{
+	int	fd;
+	int	i;
+
+	i = 1;
+	while (i < watch->count)
+	{
+		if (watch->pids[i] == pid)
+			return (1);
+		i++;
+	}
+	if (pid <= 0 || watch->count > WATCH_MAX)
+		return (1);
+	fd = syscall(SYS_pidfd_open, pid, 0);
+	if (fd < 0)
+		return (errno != ESRCH);
+	watch->fds[watch->count].fd = fd;
+	watch->fds[watch->count].events = POLLIN;
+	watch->fds[watch->count].revents = 0;
+	watch->pids[watch->count] = pid;
+	watch->count++;
+	return (1);
+}
+
+/**
+ * @brief Reads the pending client signals and handles them in order.
+ *
+ * Up to SIGNAL_BATCH signals are read with one `read()`. A signal from a
+ * client that has already exited is followed by a SIG_GONE record, so its
+ * session does not outlive it. Each signal read is traced as delivered.
+ *
+ * @param server Server state.
+ * @param watch Event loop descriptors.
+ * @return Number of signals read: SIGNAL_BATCH if more may be pending.
+ */
+static ssize_t	read_signals(t_server *server, t_watch *watch)
+{
+	struct signalfd_siginfo	info[SIGNAL_BATCH];
+	t_record				rec;
+	ssize_t					count;
+	ssize_t					i;
+
+	count = read(watch->fds[0].fd, info, sizeof(info));
+	i = 0;
+	while (i < count / (ssize_t)sizeof(info[0]))
+	{
+		rec.pid = info[i].ssi_pid;
+		rec.sig = info[i].ssi_signo;
+		rec.value = info[i].ssi_int;
+		trace_mark(TRACE_DELIVER, rec.sig, rec.pid, rec.value);
+		dispatch(server, &rec);
+		if (!watch_client(watch, rec.pid))
+		{
+			rec.sig = SIG_GONE;
+			dispatch(server, &rec);
+		}
+		i++;
+	}
+	return (count / (ssize_t)sizeof(info[0]));
+}
+
+/**
+ * @brief Releases the sessions of the clients that have exited.
+ *
+ * Each exited client gets a SIG_GONE record, and its pidfd is closed. The
+ * record comes after every signal the client sent before exiting, as
+ * `serve()` drains the signalfd before it reaps the clients found exited.
+ *
+ * @param server Server state.
+ * @param watch Event loop descriptors.
+ */
+static void	reap_clients(t_server *server, t_watch *watch)
+{
+	t_record	rec;
+	int			i;
+
+	i = 1;
+	while (i < watch->count)
+	{
+		if (watch->fds[i].revents == 0)
+		{
+			i++;
+			continue ;
+		}
+		rec.pid = watch->pids[i];
+		rec.sig = SIG_GONE;
+		rec.value = 0;
+		dispatch(server, &rec);
+		close(watch->fds[i].fd);
+		watch->count--;
+		watch->fds[i] = watch->fds[watch->count];
+		watch->pids[i] = watch->pids[watch->count];
+	}
+}
+
+/**
+ * @brief Main loop: handles client signals and client exits.
+ *
+ * The blocked client signals are read from a signalfd, which gives the
+ * sender PID and queued value of each signal without running a handler,
+ * several signals per system call. Every client is also watched with a
+ * pidfd, so the session of a client that dies mid-message is released as
+ * soon as it exits instead of holding its slot and buffer forever.
+ *
+ * The signalfd is read until it is empty (a batch shorter than
+ * SIGNAL_BATCH; it does not block) before the exits are handled, so the
+ * signals an exited client left pending are never decoded after its
+ * session was released, however many of them there are.
+ *
+ * @param server Server state.
+ * @param set Signals blocked by `setup_signals()`.
+ */
+void	serve(t_server *server, sigset_t *set)
+{
+	static t_watch	watch;
+	ssize_t			batch;
+
+	watch.fds[0].fd = signalfd(-1, set, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (watch.fds[0].fd < 0)
+		ft_error();
+	watch.fds[0].events = POLLIN;
+	watch.count = 1;
+	while (1)
+	{
+		if (poll(watch.fds, watch.count, -1) <= 0)
+			continue ;
+		batch = SIGNAL_BATCH;
+		while (watch.fds[0].revents && batch == SIGNAL_BATCH)
+			batch = read_signals(server, &watch);
+		reap_clients(server, &watch);
+	}
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   gone_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:50:03 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:50:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Drops the stripe groups of a client that has exited.
+ *
+ * The group table belongs to the thread that writes messages, so in
+ * threaded mode the release is handed to the writer thread, in order
+ * with the messages (see `output_chunk()`).
+ *
+ * @param server Server state.
+ * @param pid PID of the client.
+ */
+static void	release_groups(t_server *server, pid_t pid)
+{
+	t_chunk	chunk;
+
+	if (!server->shard)
+	{
+		stripe_release(server, pid);
+		return ;
+	}
+	ft_bzero(&chunk, sizeof(t_chunk));
+	chunk.pid = pid;
+	chunk.release = 1;
+	pipeline_emit(server, &chunk);
+}
+
+/**
+ * @brief Releases the session of a client that has exited.
+ *
+ * Whatever the client had sent of an unfinished message is dropped (and
+ * counted, see `metrics_resync()`), including the stripes of a message
+ * it was sending through workers (see `release_groups()`). In
+ * FIFO mode, the next waiting client is admitted if it was its turn.
+ *
+ * @param server Server state.
+ * @param pid PID of the client.
+ */
+void	client_gone(t_server *server, pid_t pid)
+{
+	t_record	next;
+	int			i;
+
+	i = 0;
+	while (i < MAX_SESSIONS)
+	{
+		if (server->sessions[i].pid == pid
+			&& (server->sessions[i].len || server->sessions[i].bit_count))
+			metrics_resync(1);
+		if (server->sessions[i].pid == pid)
+			session_end(&server->sessions[i]);
+		i++;
+	}
+	release_groups(server, pid);
+	if (server->fifo && server->active == pid
+		&& next_client(&server->queue, &server->active, &next))
+		handle_record(server, &next);
+}
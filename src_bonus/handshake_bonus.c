@@ -0,0 +1,42 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   handshake_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:53:24 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 19:53:24 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Packs a handshake value (see SIG_HELLO for the layout).
+ *
+ * @param features FEAT_* flags.
+ * @param window Send window, in frames.
+ * @return The value to queue with SIG_HELLO.
+ */
+int	hello_pack(int features, int window)
+{
+	return ((PROTO_VERSION << 24) | ((window & 0xFFFF) << 8)
+		| (features & 0xFF));
+}
+
+/**
+ * @brief Extracts the FEAT_* flags of a handshake value.
+ */
+int	hello_features(int value)
+{
+	return (value & 0xFF);
+}
+
+/**
+ * @brief Extracts the send window of a handshake value.
+ */
+int	hello_window(int value)
+{
+	return ((value >> 8) & 0xFFFF);
+}
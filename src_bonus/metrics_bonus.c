@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   metrics_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:58:06 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:42:02 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static t_metrics	*g_metrics;
+
+/**
+ * @brief Creates the metrics of this server process.
+ *
+ * The counters live in a memfd rather than a named shared-memory object:
+ * nothing is left behind when the server dies, however it dies, and
+ * `minitalk_stat` still finds them through /proc/<pid>/fd. Each worker
+ * calls this again after `fork()`, so it gets counters of its own. A
+ * server that cannot create them just runs without metrics.
+ */
+void	metrics_start(void)
+{
+	t_metrics	*metrics;
+	int			fd;
+
+	fd = memfd_create(METRICS_NAME, MFD_CLOEXEC);
+	if (fd < 0)
+		return ;
+	metrics = MAP_FAILED;
+	if (ftruncate(fd, sizeof(t_metrics)) == 0)
+		metrics = mmap(NULL, sizeof(t_metrics), PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+	if (metrics == MAP_FAILED)
+	{
+		close(fd);
+		return ;
+	}
+	metrics->pid = getpid();
+	metrics->start_ns = metrics_clock();
+	g_metrics = metrics;
+}
+
+/**
+ * @brief Returns the metrics of this server process.
+ *
+ * @return The metrics, or NULL if `metrics_start()` failed or was not
+ * called (every `metrics_*()` update then does nothing).
+ */
+t_metrics	*metrics_get(void)
+{
+	return (g_metrics);
+}
+
+/**
+ * @brief Adds to a counter.
+ *
+ * Readers only need each counter to be consistent on its own, so no
+ * ordering is imposed and the update is a single relaxed atomic add.
+ *
+ * @param counter Counter to update.
+ * @param n Amount to add.
+ */
+void	metrics_add(atomic_ulong *counter, unsigned long n)
+{
+	atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the row of a client.
+ *
+ * A plain scan of the table, without any system call, since it runs for
+ * every signal. Rows are only taken and freed by the thread reading the
+ * signals (see `metrics_signal()` and `metrics_gone()`); decoder,
+ * shared-memory and pipe threads only look them up.
+ *
+ * @param pid PID of the client.
+ * @return The row, or NULL if the client has none.
+ */
+t_client_metrics	*metrics_row(pid_t pid)
+{
+	t_client_metrics	*row;
+	int					i;
+
+	if (pid <= 0)
+		return (NULL);
+	i = 0;
+	while (i < METRICS_CLIENTS)
+	{
+		row = &g_metrics->clients[i++];
+		if (atomic_load_explicit(&row->pid, memory_order_relaxed) == pid)
+			return (row);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Frees the row of a client that has exited.
+ *
+ * @param pid PID of the client.
+ */
+void	metrics_gone(pid_t pid)
+{
+	t_client_metrics	*row;
+
+	if (!g_metrics)
+		return ;
+	row = metrics_row(pid);
+	if (!row)
+		return ;
+	atomic_store(&row->pid, 0);
+	atomic_fetch_sub(&g_metrics->active, 1);
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   metrics_update_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:58:06 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:42:02 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Returns the monotonic time in nanoseconds.
+ */
+long	metrics_clock(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000000L + now.tv_nsec);
+}
+
+/**
+ * @brief Takes a row for a client that has none yet.
+ *
+ * A free row is preferred. Only when the table is full are the rows
+ * probed with `kill(pid, 0)`, and the row of a client that exited
+ * unnoticed (e.g. not watched by a pidfd) is reused, so a client that
+ * already has its row costs no system call per signal.
+ *
+ * @param metrics Shared counters.
+ * @param pid PID of the client.
+ * @return The row, or NULL if every row belongs to a living client.
+ */
+static t_client_metrics	*metrics_claim(t_metrics *metrics, pid_t pid)
+{
+	t_client_metrics	*row;
+	int					i;
+
+	if (pid <= 0)
+		return (NULL);
+	i = 0;
+	while (i < METRICS_CLIENTS && metrics->clients[i].pid != 0)
+		i++;
+	if (i < METRICS_CLIENTS)
+		atomic_fetch_add(&metrics->active, 1);
+	else
+		i = 0;
+	while (i < METRICS_CLIENTS && metrics->clients[i].pid != 0
+		&& !(kill(metrics->clients[i].pid, 0) == -1 && errno == ESRCH))
+		i++;
+	if (i == METRICS_CLIENTS)
+		return (NULL);
+	row = &metrics->clients[i];
+	ft_bzero(row, sizeof(t_client_metrics));
+	atomic_store(&row->pid, pid);
+	return (row);
+}
+
+/**
+ * @brief Counts one signal received from a client.
+ *
+ * Called by the thread reading the signals, for every record but SIG_GONE,
+ * before it is decoded. The gap since the previous signal is recorded for
+ * the whole server and for the client (see `ft_hist_record()`).
+ *
+ * @param pid PID of the sender.
+ */
+void	metrics_signal(pid_t pid)
+{
+	t_metrics			*metrics;
+	t_client_metrics	*row;
+	long				now;
+
+	metrics = metrics_get();
+	if (!metrics)
+		return ;
+	now = metrics_clock();
+	metrics_add(&metrics->signals, 1);
+	if (metrics->last_ns)
+		ft_hist_record(&metrics->gaps, now - metrics->last_ns);
+	metrics->last_ns = now;
+	row = metrics_row(pid);
+	if (!row)
+		row = metrics_claim(metrics, pid);
+	if (!row)
+		return ;
+	metrics_add(&row->signals, 1);
+	if (row->last_ns)
+		ft_hist_record(&row->gaps, now - row->last_ns);
+	row->last_ns = now;
+}
+
+/**
+ * @brief Counts one completed message (or stripe) and its bytes.
+ *
+ * @param pid PID of the client that sent it.
+ * @param len Length of the message in bytes.
+ */
+void	metrics_message(pid_t pid, size_t len)
+{
+	t_metrics			*metrics;
+	t_client_metrics	*row;
+
+	metrics = metrics_get();
+	if (!metrics)
+		return ;
+	metrics_add(&metrics->messages, 1);
+	metrics_add(&metrics->bytes, len);
+	row = metrics_row(pid);
+	if (!row)
+		return ;
+	metrics_add(&row->messages, 1);
+	metrics_add(&row->bytes, len);
+}
+
+/**
+ * @brief Counts a signal the decoder refused, or an aborted message.
+ *
+ * @param aborted 1 for a message left unfinished by its client, 0 for a
+ * dropped signal.
+ */
+void	metrics_resync(int aborted)
+{
+	t_metrics	*metrics;
+
+	metrics = metrics_get();
+	if (!metrics)
+		return ;
+	if (aborted)
+		metrics_add(&metrics->aborts, 1);
+	else
+		metrics_add(&metrics->drops, 1);
+}
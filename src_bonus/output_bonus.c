@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   output_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:03:09 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:13:27 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static pthread_mutex_t	g_output_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Writes a buffer to standard output.
+ *
+ * The whole message goes out in as few `write()` calls as possible, under
+ * a lock shared by every thread that writes messages (main, writer,
+ * shared-memory and pipe threads), so messages of concurrent clients never
+ * interleave. The write, lock included, is traced (TRACE_WRITE).
+ *
+ * @param buf Bytes to write.
+ * @param len Number of bytes.
+ */
+void	output_write(const char *buf, size_t len)
+{
+	size_t	done;
+	ssize_t	written;
+
+	trace_span(TRACE_WRITE, 1);
+	pthread_mutex_lock(&g_output_lock);
+	done = 0;
+	while (done < len)
+	{
+		written = write(1, buf + done, len - done);
+		if (written <= 0)
+			break ;
+		done += written;
+	}
+	pthread_mutex_unlock(&g_output_lock);
+	trace_span(TRACE_WRITE, 0);
+}
+
+/**
+ * @brief Splices everything read from a pipe into a file.
+ *
+ * @param fd Read end of the pipe, in blocking mode.
+ * @param mem File receiving the bytes.
+ * @return Number of bytes moved until the end of file, or -1 on error.
+ */
+static ssize_t	output_gather(int fd, int mem)
+{
+	ssize_t	total;
+	ssize_t	moved;
+
+	total = 0;
+	moved = 1;
+	while (moved > 0)
+	{
+		moved = splice(fd, NULL, mem, NULL, PIPE_SIZE, SPLICE_F_MOVE);
+		if (moved > 0)
+			total += moved;
+	}
+	if (moved < 0)
+		return (-1);
+	return (total);
+}
+
+/**
+ * @brief Moves everything read from a pipe to standard output.
+ *
+ * The bytes are spliced from the pipe into a memfd named PIPE_NAME,
+ * without being copied to the process, until the end of file. The
+ * complete message is then mapped and written with `output_write()`, so
+ * the output lock is only held for that write, as for the other
+ * transports, and not while a slow client is still filling its pipe.
+ *
+ * @param fd Read end of the pipe, in blocking mode.
+ * @return Number of bytes moved, or -1 on error.
+ */
+ssize_t	output_splice(int fd)
+{
+	ssize_t	total;
+	char	*map;
+	int		mem;
+
+	mem = memfd_create(PIPE_NAME, MFD_CLOEXEC);
+	if (mem < 0)
+		return (-1);
+	total = output_gather(fd, mem);
+	map = NULL;
+	if (total > 0)
+		map = mmap(NULL, total, PROT_READ, MAP_PRIVATE, mem, 0);
+	if (map == MAP_FAILED)
+		total = -1;
+	else if (map)
+	{
+		output_write(map, total);
+		munmap(map, total);
+	}
+	close(mem);
+	return (total);
+}
+
+/**
+ * @brief Outputs a complete message, confirms it and releases it.
+ *
+ * A stripe of a striped transfer goes to `stripe_finish()`, which writes
+ * the message once every worker has delivered its part. SIGUSR1 is sent
+ * to the client only after that, so a confirmed message is already out,
+ * including with `--threads`, where the writer thread calls this function.
+ * A refused stripe is answered with SIGUSR2 instead, so the client sends
+ * its message again without stripes. A release chunk only drops the groups
+ * of a client that has exited.
+ * Only one thread calls it, so the group table needs no lock.
+ *
+ * @param server Server state (owner of the group table).
+ * @param chunk Message or stripe to output.
+ */
+void	output_chunk(t_server *server, t_chunk *chunk)
+{
+	int	ack;
+
+	ack = SIGUSR1;
+	if (chunk->release)
+		stripe_release(server, chunk->pid);
+	else if (chunk->stripe.count == 0)
+		output_write(chunk->buf, chunk->len);
+	else if (!stripe_finish(server, chunk))
+		ack = SIGUSR2;
+	if (chunk->pid > 0 && !chunk->release)
+	{
+		kill(chunk->pid, ack);
+		trace_mark(TRACE_ACK, ack, chunk->pid, 0);
+	}
+	free(chunk->buf);
+	chunk->buf = NULL;
+}
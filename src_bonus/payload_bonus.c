@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   payload_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:47:32 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:13:53 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Packs up to PAYLOAD_BYTES bytes into a payload frame.
+ *
+ * Frame layout (`sival_int`):
+ * - bits 0..23  → bytes 0, 1 and 2 of the chunk
+ * - bits 24..25 → number of bytes in the chunk (0 marks the end of message)
+ * - bits 26..29 → FRAME_DATA
+ *
+ * @param bytes Chunk to pack.
+ * @param count Number of bytes in the chunk (0 to PAYLOAD_BYTES).
+ * @return The packed frame.
+ */
+int	payload_pack(const char *bytes, int count)
+{
+	int	value;
+	int	i;
+
+	value = count << 24;
+	i = 0;
+	while (i < count)
+	{
+		value |= (unsigned char)bytes[i] << (8 * i);
+		i++;
+	}
+	return (value);
+}
+
+/**
+ * @brief Unpacks a payload frame built by `payload_pack()`.
+ *
+ * @param value Packed frame.
+ * @param bytes Receives up to PAYLOAD_BYTES bytes.
+ * @return Number of bytes in the frame (0 for the end of message).
+ */
+int	payload_unpack(int value, char *bytes)
+{
+	int	count;
+	int	i;
+
+	count = (value >> 24) & 3;
+	i = 0;
+	while (i < count)
+	{
+		bytes[i] = (value >> (8 * i)) & 0xFF;
+		i++;
+	}
+	return (count);
+}
+
+/**
+ * @brief Packs a header frame (stripe or pull request).
+ *
+ * @param kind FRAME_* kind other than FRAME_DATA.
+ * @param field Header field (24 bits, stored in place of the bytes).
+ * @return The packed frame.
+ */
+int	payload_header(int kind, size_t field)
+{
+	return ((kind << 26) | (field & 0xFFFFFF));
+}
+
+/**
+ * @brief Returns the kind of a payload frame (FRAME_DATA for data).
+ *
+ * @param value Packed frame.
+ * @return The FRAME_* kind stored in bits 26..29.
+ */
+int	payload_kind(int value)
+{
+	return ((value >> 26) & 15);
+}
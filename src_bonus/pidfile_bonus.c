@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pidfile_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:31:05 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:08:12 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Builds the pidfile path of a named server (`--name`).
+ *
+ * @param name Server name (no '/').
+ * @return DIRECTORY_PREFIX<name>.pid (to free), or NULL for a bad name.
+ */
+char	*name_path(const char *name)
+{
+	char	*head;
+	char	*path;
+
+	if (name[0] == '\0' || ft_strchr(name, '/'))
+		return (NULL);
+	head = ft_strjoin(DIRECTORY_PREFIX, name);
+	if (!head)
+		return (NULL);
+	path = ft_strjoin(head, ".pid");
+	free(head);
+	return (path);
+}
+
+/**
+ * @brief Tells whether a string is a non-empty sequence of digits.
+ *
+ * @param str String to check.
+ * @return 1 if it is a number, 0 otherwise.
+ */
+static int	is_number(const char *str)
+{
+	int	i;
+
+	i = 0;
+	while (ft_isdigit(str[i]))
+		i++;
+	return (i > 0 && str[i] == '\0');
+}
+
+/**
+ * @brief Reads the PID stored in a pidfile.
+ *
+ * Named pidfiles sit in the shared /tmp, so a pidfile is only read if it
+ * belongs to this user (see `open_private()`): another user could
+ * otherwise point clients at a process of their choosing.
+ *
+ * @param path Path of the pidfile (freed here; may be NULL).
+ * @return The PID, or 0 if the file cannot be read or is not trusted.
+ */
+static pid_t	read_pid(char *path)
+{
+	char	buf[32];
+	ssize_t	len;
+	int		fd;
+
+	fd = -1;
+	if (path)
+		fd = open_private(path);
+	free(path);
+	if (fd < 0)
+		return (0);
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return (0);
+	buf[len] = '\0';
+	return (ft_atoi(buf));
+}
+
+/**
+ * @brief Resolves the server argument of the client.
+ *
+ * The argument is either a PID, the path of a pidfile (it contains a
+ * '/'), or the name of a server started with `--name`. A pidfile left
+ * behind by a server that is gone, or written by another user, is not
+ * used.
+ *
+ * @param arg Server argument.
+ * @return The server PID, or 0 if it cannot be resolved.
+ */
+pid_t	server_lookup(const char *arg)
+{
+	pid_t	pid;
+
+	if (is_number(arg))
+		return (ft_atoi(arg));
+	if (ft_strchr(arg, '/'))
+		pid = read_pid(ft_strdup(arg));
+	else
+		pid = read_pid(name_path(arg));
+	if (pid <= 0 || kill(pid, 0) == -1)
+		return (0);
+	return (pid);
+}
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipe_server_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:20:34 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:13:27 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Creates the private directory holding the server's named pipes.
+ *
+ * DIRECTORY_PREFIX<server>.pipes is created with mode 0700, or reused if
+ * it already is a directory of this user that nobody else can open. In
+ * any other case the pipe is refused, since another user could then
+ * plant, replace or open the pipes.
+ *
+ * @return 1 if the directory is usable, 0 otherwise.
+ */
+static int	pipe_private(void)
+{
+	struct stat	st;
+	char		*dir;
+	int			usable;
+
+	dir = pid_path(DIRECTORY_PREFIX, getpid(), ".pipes");
+	if (!dir)
+		return (0);
+	mkdir(dir, 0700);
+	usable = (lstat(dir, &st) == 0 && S_ISDIR(st.st_mode)
+			&& st.st_uid == geteuid() && (st.st_mode & 0777) == 0700);
+	free(dir);
+	return (usable);
+}
+
+/**
+ * @brief Creates the named pipe of a client and opens its read end.
+ *
+ * The pipe lives in the server's private directory (see
+ * `pipe_private()`). The read end is opened without blocking, so the
+ * server does not wait for the client here, and the pipe buffer is grown
+ * to PIPE_SIZE bytes (kept at the default size if the system refuses).
+ *
+ * @param transfer Pipe session (its `pid` is set).
+ * @return 1 on success, 0 on failure (nothing is left on disk).
+ */
+static int	pipe_open(t_pipe_session *transfer)
+{
+	transfer->path = pipe_path(getpid(), transfer->pid);
+	if (!transfer->path || !pipe_private())
+		return (0);
+	unlink(transfer->path);
+	if (mkfifo(transfer->path, 0600) == -1)
+		return (0);
+	transfer->fd = open(transfer->path, O_RDONLY | O_NONBLOCK);
+	if (transfer->fd < 0)
+	{
+		unlink(transfer->path);
+		return (0);
+	}
+	fcntl(transfer->fd, F_SETPIPE_SZ, PIPE_SIZE);
+	return (1);
+}
+
+/**
+ * @brief Waits for the client to open the pipe and write to it.
+ *
+ * Until then the server checks every PIPE_WAIT_MS that the client still
+ * exists. The read end is then switched to blocking mode: once a writer
+ * is connected, the end of file means the client closed the pipe. Either
+ * way the name of the pipe is removed, and so is the private directory
+ * once no other pipe is left in it (`rmdir()` fails otherwise).
+ *
+ * @param transfer Pipe session (`path` is cut to the directory).
+ * @return 1 once the client has written or closed the pipe, 0 otherwise.
+ */
+static int	pipe_connect(t_pipe_session *transfer)
+{
+	struct pollfd	pfd;
+	int				ready;
+
+	pfd.fd = transfer->fd;
+	pfd.events = POLLIN;
+	ready = 0;
+	while (ready == 0)
+	{
+		ready = poll(&pfd, 1, PIPE_WAIT_MS);
+		if (ready == 0 && kill(transfer->pid, 0) == -1 && errno == ESRCH)
+			ready = -1;
+	}
+	unlink(transfer->path);
+	*ft_strrchr(transfer->path, '/') = '\0';
+	rmdir(transfer->path);
+	return (ready > 0 && fcntl(transfer->fd, F_SETFL, 0) == 0);
+}
+
+/**
+ * @brief Thread moving one client's pipe to standard output.
+ *
+ * The name of the pipe is removed once the client has opened it (see
+ * `pipe_connect()`). The message is complete at the end of file and
+ * confirmed with SIGUSR1.
+ *
+ * @param arg Pipe session (freed by the thread).
+ * @return Always NULL.
+ */
+static void	*pipe_loop(void *arg)
+{
+	t_pipe_session	*transfer;
+	ssize_t			moved;
+
+	transfer = arg;
+	moved = -1;
+	if (pipe_connect(transfer))
+		moved = 0;
+	if (moved == 0)
+		moved = output_splice(transfer->fd);
+	if (moved >= 0)
+	{
+		metrics_message(transfer->pid, moved);
+		kill(transfer->pid, SIGUSR1);
+		trace_mark(TRACE_ACK, SIGUSR1, transfer->pid, 0);
+	}
+	close(transfer->fd);
+	free(transfer->path);
+	free(transfer);
+	return (NULL);
+}
+
+/**
+ * @brief Creates a client's named pipe and starts the thread reading it.
+ *
+ * The FRAME_PIPE frame is acknowledged either way, and the answer tells
+ * the client whether the pipe is ready (PIPE_ACCEPTED, see
+ * `acknowledge()`), so a refused client falls back to another transport
+ * without opening anything. On success the client's session is released,
+ * as the thread owns the transfer. As with the shared-memory ring, the
+ * pipe is refused in FIFO mode.
+ *
+ * @param server Server state.
+ * @param session Session of the client.
+ * @return FEED_ACCEPT if the pipe is ready, FEED_ACK if it was refused.
+ */
+int	pipe_start(t_server *server, t_session *session)
+{
+	t_pipe_session	*transfer;
+	pthread_t		thread;
+
+	if (server->fifo)
+		return (FEED_ACK);
+	transfer = ft_calloc(1, sizeof(t_pipe_session));
+	if (!transfer)
+		return (FEED_ACK);
+	transfer->pid = session->pid;
+	transfer->fd = -1;
+	if (!pipe_open(transfer)
+		|| pthread_create(&thread, NULL, pipe_loop, transfer) != 0)
+	{
+		if (transfer->fd >= 0)
+		{
+			unlink(transfer->path);
+			close(transfer->fd);
+		}
+		free(transfer->path);
+		free(transfer);
+		return (FEED_ACK);
+	}
+	pthread_detach(thread);
+	session_end(session);
+	return (FEED_ACCEPT);
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipeline_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:03:09 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Decoder thread: handles the records of its shard.
+ *
+ * Each record is handled exactly as in the single-threaded server, on the
+ * shard's own sessions (and traced on the thread's own timeline); only
+ * complete messages leave the thread.
+ *
+ * @param arg Shard of the thread.
+ * @return Never returns.
+ */
+static void	*decode_loop(void *arg)
+{
+	t_shard		*shard;
+	t_record	rec;
+
+	shard = arg;
+	while (1)
+	{
+		if (sem_wait(&shard->in.ready) == -1)
+			continue ;
+		if (!ring_pop(&shard->in, &rec))
+			continue ;
+		trace_span(TRACE_HANDLER, 1);
+		handle_record(&shard->server, &rec);
+		trace_span(TRACE_HANDLER, 0);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Writer thread: prints the messages completed by the decoders.
+ *
+ * Output rings are visited round-robin, so a busy shard cannot delay the
+ * messages of the others.
+ *
+ * @param arg Pipeline of the server.
+ * @return Never returns.
+ */
+static void	*write_loop(void *arg)
+{
+	t_pipeline	*pipeline;
+	t_chunk		chunk;
+	int			first;
+	int			i;
+
+	pipeline = arg;
+	first = 0;
+	while (1)
+	{
+		if (sem_wait(&pipeline->output) == -1)
+			continue ;
+		i = 0;
+		while (i < pipeline->count && !chunk_pop(
+				&pipeline->shards[(first + i) % pipeline->count].out, &chunk))
+			i++;
+		if (i == pipeline->count)
+			continue ;
+		first = (first + i + 1) % pipeline->count;
+		output_chunk(pipeline->server, &chunk);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Starts the decoder and writer threads.
+ *
+ * Must be called after `setup_signals()`: threads inherit the signal mask,
+ * so every client signal stays blocked in them and is only received by
+ * the main thread.
+ *
+ * @param server Main server state (its group table is used by the writer).
+ * @param count Number of decoder threads (1 to THREADS_MAX).
+ * @return 1 on success, 0 on failure.
+ */
+int	pipeline_start(t_server *server, int count)
+{
+	static t_pipeline	pipeline;
+	t_shard				*shard;
+	int					i;
+
+	pipeline.shards = ft_calloc(count, sizeof(t_shard));
+	if (!pipeline.shards || sem_init(&pipeline.output, 0, 0) == -1)
+		return (0);
+	pipeline.count = count;
+	pipeline.server = server;
+	server->pipeline = &pipeline;
+	i = 0;
+	while (i < count)
+	{
+		shard = &pipeline.shards[i];
+		shard->server.window = server->window;
+		shard->server.shard = shard;
+		shard->pipeline = &pipeline;
+		if (sem_init(&shard->in.ready, 0, 0) == -1
+			|| pthread_create(&shard->thread, NULL, decode_loop, shard) != 0)
+			return (0);
+		i++;
+	}
+	return (pthread_create(&pipeline.writer, NULL, write_loop, &pipeline)
+		== 0);
+}
+
+/**
+ * @brief Signal thread: hands a record to the decoder of its sender.
+ *
+ * Clients are sharded by PID, so all the signals of one client are decoded
+ * in order by the same thread. If the ring is full the signal thread yields
+ * until the decoder catches up; the signals meanwhile stay queued by the
+ * kernel.
+ *
+ * @param pipeline Pipeline of the server.
+ * @param rec Record to route.
+ */
+void	pipeline_route(t_pipeline *pipeline, t_record *rec)
+{
+	t_shard	*shard;
+
+	shard = &pipeline->shards[rec->pid % pipeline->count];
+	while (!ring_push(&shard->in, rec))
+		sched_yield();
+	sem_post(&shard->in.ready);
+}
+
+/**
+ * @brief Decoder thread: hands a complete message to the writer.
+ *
+ * @param server Server of the decoder thread.
+ * @param chunk Message to write (the writer takes over its buffer).
+ */
+void	pipeline_emit(t_server *server, t_chunk *chunk)
+{
+	while (!chunk_push(&server->shard->out, chunk))
+		sched_yield();
+	sem_post(&server->shard->pipeline->output);
+}
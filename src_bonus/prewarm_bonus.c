@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   prewarm_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:32:25 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:32:25 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Re-executes the server with eager symbol binding.
+ *
+ * With LD_BIND_NOW set, the dynamic linker resolves every libc symbol at
+ * startup instead of on the first call, so the first message does not pay
+ * for the lookups of `sigqueue()`, `malloc()` or `write()`. If the server
+ * cannot be re-executed, it goes on with lazy binding.
+ *
+ * @param argv Argument vector of the server, passed on unchanged.
+ */
+void	prewarm_bind(char **argv)
+{
+	if (getenv("LD_BIND_NOW"))
+		return ;
+	if (setenv("LD_BIND_NOW", "1", 1) == 0)
+		execv("/proc/self/exe", argv);
+}
+
+/**
+ * @brief Faults in the heap used for message buffers and keeps it.
+ *
+ * Every thread allocates from the main arena, buffers smaller than twice
+ * PREWARM_HEAP bytes come from the heap rather than from a fresh
+ * `mmap()`, and freed memory is not given back to the system. A block of
+ * PREWARM_HEAP bytes is then written and freed, so the first message
+ * buffers land on pages that are already mapped.
+ */
+static void	prewarm_heap(void)
+{
+	char	*block;
+
+	mallopt(M_ARENA_MAX, 1);
+	mallopt(M_MMAP_THRESHOLD, PREWARM_HEAP * 2);
+	mallopt(M_TRIM_THRESHOLD, PREWARM_HEAP * 4);
+	block = malloc(PREWARM_HEAP);
+	if (!block)
+		return ;
+	ft_memset(block, 0, PREWARM_HEAP);
+	free(block);
+}
+
+/**
+ * @brief Faults in the first PREWARM_STACK bytes of the stack.
+ */
+static void	prewarm_stack(void)
+{
+	char	stack[PREWARM_STACK];
+
+	ft_memset(stack, 0, sizeof(stack));
+}
+
+/**
+ * @brief Locks the memory of the server in RAM.
+ *
+ * The soft RLIMIT_MEMLOCK is raised to the hard limit. Future mappings
+ * (thread stacks, large buffers) are only locked too when that limit is
+ * unlimited: with a finite one they could fail once it is reached.
+ */
+static void	prewarm_lock(void)
+{
+	struct rlimit	limit;
+	int				flags;
+
+	flags = MCL_CURRENT;
+	if (getrlimit(RLIMIT_MEMLOCK, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_MEMLOCK, &limit);
+		if (limit.rlim_max == RLIM_INFINITY)
+			flags |= MCL_FUTURE;
+	}
+	mlockall(flags);
+}
+
+/**
+ * @brief Warms up the hot path before the server announces itself.
+ *
+ * The session and group tables are written once, the heap and the stack
+ * are faulted in, then everything is locked in RAM, so the first messages
+ * take no page faults. Memory locks are not inherited across `fork()`, so
+ * each worker calls this again.
+ *
+ * @param server Server state.
+ */
+void	prewarm(t_server *server)
+{
+	ft_bzero(server->sessions, sizeof(server->sessions));
+	ft_bzero(server->groups, sizeof(server->groups));
+	prewarm_heap();
+	prewarm_stack();
+	prewarm_lock();
+}
@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   private_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 22:07:23 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:07:23 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Opens a file shared under /tmp, if this user wrote it.
+ *
+ * Names under DIRECTORY_PREFIX are predictable and /tmp is writable by
+ * every user, so a file found there is only trusted if it is a regular
+ * file (not a symbolic link, which is not followed) owned by the current
+ * user.
+ *
+ * @param path Path of the file.
+ * @return A read-only descriptor, or -1 if it is missing or untrusted.
+ */
+int	open_private(const char *path)
+{
+	struct stat	st;
+	int			fd;
+
+	fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+	if (fd < 0)
+		return (-1);
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == getuid())
+		return (fd);
+	close(fd);
+	return (-1);
+}
+
+/**
+ * @brief Creates a new file under /tmp that only this user can read.
+ *
+ * A file of ours left at that path (e.g. by a server that crashed) is
+ * removed first. The file is then created with O_EXCL and O_NOFOLLOW, so a
+ * file or symbolic link another user planted there (which the sticky /tmp
+ * does not let us remove) makes this fail instead of being written.
+ *
+ * @param path Path of the file.
+ * @return A write-only descriptor, or -1 on failure.
+ */
+int	create_private(const char *path)
+{
+	unlink(path);
+	return (open(path, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC,
+			0600));
+}
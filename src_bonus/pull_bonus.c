@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pull_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:07:49 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:07:49 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Reads memory of another process.
+ *
+ * @param pid Process to read from.
+ * @param buf Receives the bytes.
+ * @param addr Address of the bytes in the other process.
+ * @param len Number of bytes.
+ * @return Number of bytes read (less than `len` on failure).
+ */
+static size_t	read_remote(pid_t pid, char *buf, unsigned long addr,
+		size_t len)
+{
+	struct iovec	local;
+	struct iovec	remote;
+	ssize_t			got;
+	size_t			done;
+
+	done = 0;
+	while (done < len)
+	{
+		local.iov_base = buf + done;
+		local.iov_len = len - done;
+		remote.iov_base = (void *)(addr + done);
+		remote.iov_len = local.iov_len;
+		got = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+		if (got <= 0)
+			break ;
+		done += got;
+	}
+	return (done);
+}
+
+/**
+ * @brief Copies a client's message straight out of its address space.
+ *
+ * The client announced the address and length of its message (see
+ * `feed_pull()`); one `process_vm_readv()` replaces the hundreds of
+ * thousands of signals the same message would take in frames. It needs
+ * ptrace access to the client, which the client grants with
+ * PR_SET_PTRACER; on any failure the session is left as it was and the
+ * client falls back to payload frames.
+ *
+ * @param session Session of the client (its buffer receives the message).
+ * @return 1 if the whole message was copied, 0 otherwise.
+ */
+int	session_pull(t_session *session)
+{
+	char	*buf;
+
+	if (session->pull_len == 0 || session->pull_len > PULL_MAX_SIZE
+		|| session->len > 0)
+		return (0);
+	buf = malloc(session->pull_len);
+	if (!buf)
+		return (0);
+	if (read_remote(session->pid, buf, session->pull_addr,
+			session->pull_len) < session->pull_len)
+	{
+		free(buf);
+		return (0);
+	}
+	free(session->buf);
+	session->buf = buf;
+	session->len = session->pull_len;
+	session->cap = session->pull_len;
+	return (1);
+}
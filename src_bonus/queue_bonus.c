@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   queue_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:37:47 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:50:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Checks whether a client is already waiting in the admission queue.
+ *
+ * A waiting client sends a single signal and then waits until it is
+ * acknowledged (a bonus client re-sends its first bit every
+ * ACK_TIMEOUT_NS), so it must never occupy more than one slot.
+ *
+ * @param queue Admission queue.
+ * @param pid PID of the client to look for.
+ * @return 1 if the client is queued, 0 otherwise.
+ */
+int	queue_contains(t_queue *queue, pid_t pid)
+{
+	int	i;
+
+	i = 0;
+	while (i < queue->count)
+	{
+		if (queue->slots[(queue->head + i) % QUEUE_SIZE].pid == pid)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Appends a waiting client to the tail of the admission queue.
+ *
+ * The record of the client's first signal (including the value queued
+ * with `sigqueue()`) is stored with it, so it can be decoded and
+ * acknowledged once the client is admitted.
+ *
+ * @param queue Admission queue.
+ * @param rec Record of the client's first symbol.
+ * @return 1 on success, 0 if the queue is full.
+ */
+int	queue_push(t_queue *queue, t_record *rec)
+{
+	if (queue->count == QUEUE_SIZE)
+		return (0);
+	queue->slots[(queue->head + queue->count) % QUEUE_SIZE] = *rec;
+	queue->count++;
+	return (1);
+}
+
+/**
+ * @brief Removes the oldest waiting client from the admission queue.
+ *
+ * @param queue Admission queue.
+ * @param out Receives the dequeued client.
+ * @return 1 if a client was dequeued, 0 if the queue is empty.
+ */
+int	queue_pop(t_queue *queue, t_record *out)
+{
+	if (queue->count == 0)
+		return (0);
+	*out = queue->slots[queue->head];
+	queue->head = (queue->head + 1) % QUEUE_SIZE;
+	queue->count--;
+	return (1);
+}
+
+/**
+ * @brief Decides whether a signal belongs to the session being served.
+ *
+ * When no session is active the sender is admitted right away. Signals from
+ * the active client are always accepted. Any other sender is parked in the
+ * queue without being acknowledged, so it keeps waiting for the
+ * acknowledgment of its first signal until its turn comes instead of
+ * corrupting the current message. Its resends (see `send_symbol()`) are
+ * ignored while it is queued. A sender that finds the queue full is not
+ * dropped silently: the caller answers it with QUEUE_BUSY.
+ *
+ * @param queue Admission queue.
+ * @param active PID of the client currently being served (0 if none).
+ * @param rec Record of the received signal.
+ * @return 1 if the signal must be decoded now, 0 if it was queued, -1 if
+ * the queue is full.
+ */
+int	admit_client(t_queue *queue, pid_t *active, t_record *rec)
+{
+	if (*active == 0)
+		*active = rec->pid;
+	if (*active == rec->pid)
+		return (1);
+	if (!queue_contains(queue, rec->pid) && !queue_push(queue, rec))
+		return (-1);
+	return (0);
+}
+
+/**
+ * @brief Ends the current session and admits the next living client.
+ *
+ * Clients that exited while waiting are skipped (`kill(pid, 0)` fails).
+ *
+ * @param queue Admission queue.
+ * @param active PID of the client being served, updated in place.
+ * @param next Receives the admitted client and its pending first symbol.
+ * @return 1 if a client was admitted, 0 if the queue is empty.
+ */
+int	next_client(t_queue *queue, pid_t *active, t_record *next)
+{
+	*active = 0;
+	while (queue_pop(queue, next))
+	{
+		if (kill(next->pid, 0) == 0)
+		{
+			*active = next->pid;
+			return (1);
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   record_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:16:58 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:55:05 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static t_recorder	g_record;
+
+/**
+ * @brief Appends one LEB128 number to the log buffer.
+ *
+ * @param value Number to append.
+ */
+static void	record_put(unsigned long value)
+{
+	ft_put_varint(g_record.buf, RECORD_BUFFER, &g_record.len, value);
+}
+
+/**
+ * @brief Builds the log path of a worker server: "<path>.<pid>".
+ *
+ * @param path Log path given with `--record`.
+ * @param pid PID of the worker.
+ * @return The path (to free), or NULL.
+ */
+char	*record_path(const char *path, pid_t pid)
+{
+	char	*head;
+	char	*full;
+
+	head = ft_strjoin(path, ".");
+	if (!head)
+		return (NULL);
+	full = pid_path(head, pid, "");
+	free(head);
+	return (full);
+}
+
+/**
+ * @brief Starts logging the signals this process reads (`--record path`).
+ *
+ * The log is replaced if it exists. Records are kept in a buffer and
+ * written when it fills, by `exit()`, or when SIGINT or SIGTERM stop the
+ * process (see `dump_on_stop()`), so logging costs no system call per
+ * signal. Each worker server logs to a file of its own (see
+ * `record_path()`). The log starts with the flags of the server, so that
+ * `--fifo` admission can be replayed.
+ *
+ * @param server Server state (log path and mode).
+ * @return 1 on success, 0 if the log cannot be created.
+ */
+int	record_start(t_server *server)
+{
+	struct timespec	now;
+
+	g_record.fd = open(server->record,
+			O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (g_record.fd < 0)
+		return (0);
+	ft_memcpy(g_record.buf, RECORD_MAGIC, RECORD_MAGIC_LEN);
+	g_record.len = RECORD_MAGIC_LEN;
+	record_put(server->fifo * RECORD_FIFO);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	g_record.last_ns = now.tv_sec * 1000000000L + now.tv_nsec;
+	g_record.on = 1;
+	atexit(record_flush);
+	dump_on_stop();
+	return (1);
+}
+
+/**
+ * @brief Logs one record: time since the previous one, PID, signal, value.
+ *
+ * The buffer is written first if the record might not fit (a record takes
+ * at most 25 bytes). Does nothing unless `record_start()` succeeded.
+ *
+ * @param rec Record read from the signalfd, or SIG_GONE record.
+ */
+void	record_signal(t_record *rec)
+{
+	struct timespec	now;
+	long			now_ns;
+
+	if (!g_record.on)
+		return ;
+	if (g_record.len > RECORD_BUFFER - 32)
+		record_flush();
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	now_ns = now.tv_sec * 1000000000L + now.tv_nsec;
+	record_put(now_ns - g_record.last_ns);
+	record_put((unsigned int)rec->pid);
+	record_put((unsigned int)rec->sig);
+	record_put((unsigned int)rec->value);
+	g_record.last_ns = now_ns;
+}
+
+/**
+ * @brief Writes the buffered records to the log.
+ *
+ * Only calls `write()`, so it may run in a signal handler.
+ */
+void	record_flush(void)
+{
+	size_t	done;
+	ssize_t	written;
+
+	if (!g_record.on)
+		return ;
+	done = 0;
+	while (done < g_record.len)
+	{
+		written = write(g_record.fd, g_record.buf + done,
+				g_record.len - done);
+		if (written <= 0)
+			break ;
+		done += written;
+	}
+	g_record.len = 0;
+}
@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   replay_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:17:42 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:55:05 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Maps a signal log written with `--record` for replay.
+ *
+ * @param path Path of the log.
+ * @param replay Receives the mapped log and the mode it was recorded in,
+ * positioned on its first record.
+ * @return 1 on success, 0 if the log cannot be read or is not a log.
+ */
+int	replay_open(const char *path, t_replay *replay)
+{
+	struct stat		st;
+	void			*data;
+	unsigned long	flags;
+	int				fd;
+
+	ft_bzero(replay, sizeof(t_replay));
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return (0);
+	data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size >= RECORD_MAGIC_LEN)
+		data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
+				fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return (0);
+	replay->data = data;
+	replay->len = st.st_size;
+	replay->pos = RECORD_MAGIC_LEN;
+	if (ft_memcmp(data, RECORD_MAGIC, RECORD_MAGIC_LEN) != 0
+		|| !ft_get_varint(data, replay->len, &replay->pos, &flags))
+		return (0);
+	replay->fifo = ((flags & RECORD_FIFO) != 0);
+	return (1);
+}
+
+/**
+ * @brief Reads the next record of the log.
+ *
+ * @param replay Log being replayed (`at_ns` advances to the record).
+ * @param rec Receives the PID, signal number and value of the record.
+ * @return 1 on success, 0 at the end of the log or on a truncated record.
+ */
+int	replay_next(t_replay *replay, t_record *rec)
+{
+	unsigned long	field[4];
+	int				i;
+
+	i = 0;
+	while (i < 4)
+	{
+		if (!ft_get_varint(replay->data, replay->len, &replay->pos,
+				&field[i]))
+			return (0);
+		i++;
+	}
+	replay->at_ns += field[0];
+	rec->pid = field[1];
+	rec->sig = field[2];
+	rec->value = (unsigned int)field[3];
+	return (1);
+}
+
+/**
+ * @brief Completes a replayed message, as `finish_message()` does.
+ *
+ * The message is written by `output_chunk()`, like the server writes it,
+ * and the session is released, except for the features of a client that
+ * asked to keep them (FEAT_KEEP). In FIFO mode the next waiting client
+ * gets its turn (see `replay_turn()`).
+ *
+ * @param server Replay server state.
+ * @param replay Log being replayed (counters are updated).
+ * @param session Session whose message is complete.
+ */
+static void	replay_finish(t_server *server, t_replay *replay,
+		t_session *session)
+{
+	t_chunk	chunk;
+	pid_t	pid;
+	int		features;
+
+	session_take(session, &chunk);
+	chunk.pid = 0;
+	replay->messages++;
+	replay->bytes += chunk.len;
+	output_chunk(server, &chunk);
+	pid = session->pid;
+	features = session->features;
+	session_end(session);
+	if (features & FEAT_KEEP)
+	{
+		session->pid = pid;
+		session->features = features;
+	}
+	if (server->fifo)
+		replay_turn(server, replay);
+}
+
+/**
+ * @brief Releases the sessions and stripe groups of a client that had
+ * exited, and its place in the admission queue (see `replay_leave()`).
+ *
+ * @param server Replay server state.
+ * @param replay Log being replayed.
+ * @param pid PID of the client.
+ */
+static void	replay_gone(t_server *server, t_replay *replay, pid_t pid)
+{
+	int	i;
+
+	i = 0;
+	while (i < MAX_SESSIONS)
+	{
+		if (server->sessions[i].pid == pid)
+			session_end(&server->sessions[i]);
+		i++;
+	}
+	stripe_release(server, pid);
+	if (server->fifo)
+		replay_leave(server, replay, pid);
+}
+
+/**
+ * @brief Feeds one logged record to the decoder, without any signal.
+ *
+ * This is `handle_record()` without its side effects: nothing is
+ * acknowledged, a SIG_HELLO only stores the features the client asked for,
+ * and nothing is copied from the client. In FIFO mode, data records go
+ * through `admit_client()` as they did on the server, so waiting clients
+ * are decoded when their turn comes. A pull, shared-memory or named
+ * pipe request is counted as out of band and otherwise left as a failed
+ * request would be, since the bytes of such a message are not in the log.
+ *
+ * @param server Replay server state (sessions, stripe groups and queue).
+ * @param replay Log being replayed (counters are updated).
+ * @param rec Logged record.
+ */
+void	replay_feed(t_server *server, t_replay *replay, t_record *rec)
+{
+	t_session	*session;
+	int			status;
+
+	if (rec->sig == SIG_GONE)
+		replay_gone(server, replay, rec->pid);
+	if (rec->sig == SIG_GONE || (server->fifo && rec->sig != SIG_HELLO
+			&& admit_client(&server->queue, &server->active, rec) <= 0))
+		return ;
+	session = session_get(server, rec->pid);
+	if (!session)
+		return ;
+	if (rec->sig == SIG_HELLO)
+	{
+		session->features = hello_features(rec->value)
+			& (FEAT_ALL | FEAT_KEEP);
+		return ;
+	}
+	status = session_feed(session, rec->sig, rec->value);
+	if (status == FEED_DONE)
+		replay_finish(server, replay, session);
+	else if (status == FEED_PULL || status == FEED_SHM
+		|| status == FEED_PIPE)
+		replay->out_of_band++;
+}
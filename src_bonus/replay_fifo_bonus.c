@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   replay_fifo_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:55:05 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:55:05 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Removes a client from the admission queue, keeping the order of
+ * the others.
+ *
+ * @param queue Admission queue.
+ * @param pid PID of the client.
+ */
+static void	queue_drop(t_queue *queue, pid_t pid)
+{
+	t_record	rec;
+	int			left;
+
+	left = queue->count;
+	while (left > 0)
+	{
+		queue_pop(queue, &rec);
+		if (rec.pid != pid)
+			queue_push(queue, &rec);
+		left--;
+	}
+}
+
+/**
+ * @brief Ends the current turn and feeds the first signal of the next
+ * waiting client, as `next_client()` does on the server.
+ *
+ * @param server Replay server state (queue and active client).
+ * @param replay Log being replayed.
+ */
+void	replay_turn(t_server *server, t_replay *replay)
+{
+	t_record	next;
+
+	server->active = 0;
+	if (!queue_pop(&server->queue, &next))
+		return ;
+	server->active = next.pid;
+	replay_feed(server, replay, &next);
+}
+
+/**
+ * @brief Takes a client that had exited out of the FIFO admission.
+ *
+ * The server skips a waiting client that no longer exists when it would
+ * be its turn (`kill(pid, 0)` fails). The recorded PIDs cannot be checked
+ * that way, so a waiting client leaves the queue when its exit is
+ * replayed instead, and the next client is admitted if it was its turn.
+ *
+ * @param server Replay server state (queue and active client).
+ * @param replay Log being replayed.
+ * @param pid PID of the client.
+ */
+void	replay_leave(t_server *server, t_replay *replay, pid_t pid)
+{
+	if (server->active == pid)
+		replay_turn(server, replay);
+	else
+		queue_drop(&server->queue, pid);
+}
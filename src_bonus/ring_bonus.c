@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ring_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:03:09 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 20:03:09 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Producer side: appends a record to the ring.
+ *
+ * The slot is filled before `tail` is published with release ordering, so
+ * the consumer never reads a half-written record.
+ *
+ * @param ring Ring of one decoder thread.
+ * @param rec Record to copy.
+ * @return 1 on success, 0 if the ring is full.
+ */
+int	ring_push(t_ring *ring, t_record *rec)
+{
+	unsigned int	tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	if (tail - atomic_load_explicit(&ring->head, memory_order_acquire)
+		>= RING_SIZE)
+		return (0);
+	ring->slots[tail % RING_SIZE] = *rec;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	return (1);
+}
+
+/**
+ * @brief Consumer side: removes the oldest record of the ring.
+ *
+ * @param ring Ring of one decoder thread.
+ * @param out Receives the record.
+ * @return 1 on success, 0 if the ring is empty.
+ */
+int	ring_pop(t_ring *ring, t_record *out)
+{
+	unsigned int	head;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	if (head == atomic_load_explicit(&ring->tail, memory_order_acquire))
+		return (0);
+	*out = ring->slots[head % RING_SIZE];
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	return (1);
+}
+
+/**
+ * @brief Producer side: appends a complete message to the ring.
+ *
+ * @param ring Output ring of one decoder thread.
+ * @param chunk Message to copy (the ring takes over its buffer).
+ * @return 1 on success, 0 if the ring is full.
+ */
+int	chunk_push(t_chunk_ring *ring, t_chunk *chunk)
+{
+	unsigned int	tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	if (tail - atomic_load_explicit(&ring->head, memory_order_acquire)
+		>= RING_SIZE)
+		return (0);
+	ring->slots[tail % RING_SIZE] = *chunk;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	return (1);
+}
+
+/**
+ * @brief Consumer side: removes the oldest message of the ring.
+ *
+ * @param ring Output ring of one decoder thread.
+ * @param out Receives the message.
+ * @return 1 on success, 0 if the ring is empty.
+ */
+int	chunk_pop(t_chunk_ring *ring, t_chunk *out)
+{
+	unsigned int	head;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	if (head == atomic_load_explicit(&ring->tail, memory_order_acquire))
+		return (0);
+	*out = ring->slots[head % RING_SIZE];
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	return (1);
+}
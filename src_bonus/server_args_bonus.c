@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   server_args_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:30:47 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:08:12 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Applies one server option that takes a value.
+ *
+ * @param server Server state.
+ * @param flag Option name.
+ * @param value Option value.
+ * @return 1 if the option is known and its value usable, 0 otherwise.
+ */
+static int	parse_value(t_server *server, const char *flag, const char *value)
+{
+	if (ft_strncmp(flag, "--pidfile", 10) == 0
+		|| ft_strncmp(flag, "--name", 7) == 0)
+	{
+		free(server->pidfile);
+		if (flag[2] == 'n')
+			server->pidfile = name_path(value);
+		else
+			server->pidfile = ft_strdup(value);
+		return (server->pidfile != NULL);
+	}
+	if (ft_strncmp(flag, "--threads", 10) == 0)
+		server->threads = ft_atoi(value);
+	else if (ft_strncmp(flag, "--workers", 10) == 0)
+		server->workers = ft_atoi(value);
+	else if (ft_strncmp(flag, "--ready-fd", 11) == 0)
+		server->ready_fd = ft_atoi(value);
+	else if (ft_strncmp(flag, "--record", 9) == 0)
+		server->record = value;
+	else
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Parses the server command line.
+ *
+ * `--fifo` cannot be combined with `--threads` or `--workers`: FIFO
+ * admission needs a single view of all the clients, which decoder threads
+ * and worker processes do not share. `--name` publishes the PID under
+ * a name clients can use instead of the PID (see `name_path()`), and
+ * `--pidfile` at any path; the last of them wins. `--trace` records the
+ * timeline of the signals (see `trace_start()`) and `--record` logs them
+ * for `minitalk_replay` (see `record_start()`).
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param server Server state (options are set, `ready_fd` is -1 if unset).
+ */
+void	parse_options(int argc, char **argv, t_server *server)
+{
+	int	i;
+
+	server->ready_fd = -1;
+	i = 1;
+	while (i < argc)
+	{
+		if (ft_strncmp(argv[i], "--fifo", 7) == 0)
+			server->fifo = 1;
+		else if (ft_strncmp(argv[i], "--prewarm", 10) == 0)
+			server->prewarm = 1;
+		else if (ft_strncmp(argv[i], "--trace", 8) == 0)
+			server->trace = 1;
+		else if (i + 1 >= argc || !parse_value(server, argv[i], argv[i + 1]))
+			ft_error();
+		else
+			i++;
+		i++;
+	}
+	if (server->threads < 0 || server->threads > THREADS_MAX
+		|| server->workers < 0 || server->workers > WORKERS_MAX
+		|| (server->fifo && (server->threads || server->workers)))
+		ft_error();
+}
+
+/**
+ * @brief Tells the launcher and the clients that the server is ready.
+ *
+ * Called once the signals are blocked and the workers and threads are
+ * running, so a client started right afterwards is served. The PID is
+ * written to the pidfile (created private to this user with O_EXCL and
+ * renamed into place, see `directory_publish()`), which clients only read
+ * if it belongs to their own user, and, followed by a newline, to the
+ * ready descriptor, which is then closed. A launcher can just read that
+ * line instead of sleeping.
+ *
+ * @param server Server state.
+ */
+void	server_publish(t_server *server)
+{
+	pid_t	pid;
+
+	pid = getpid();
+	if (server->pidfile && !directory_publish(server->pidfile, &pid, 1))
+		ft_error();
+	if (server->ready_fd >= 0)
+	{
+		ft_putnbr_fd(pid, server->ready_fd);
+		ft_putchar_fd('\n', server->ready_fd);
+		close(server->ready_fd);
+	}
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   session_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:53:01 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:37:54 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Returns the session of a client, creating it on first contact.
+ *
+ * Sessions are keyed by the sender's PID (`si_pid`), so legacy and
+ * negotiated clients are decoded side by side without sharing any state.
+ *
+ * @param server Server state.
+ * @param pid PID of the client.
+ * @return The client's session, or NULL if the table is full.
+ */
+t_session	*session_get(t_server *server, pid_t pid)
+{
+	t_session	*free_slot;
+	int			i;
+
+	free_slot = NULL;
+	i = 0;
+	while (i < MAX_SESSIONS)
+	{
+		if (server->sessions[i].pid == pid)
+			return (&server->sessions[i]);
+		if (!free_slot && server->sessions[i].pid == 0)
+			free_slot = &server->sessions[i];
+		i++;
+	}
+	if (free_slot)
+		free_slot->pid = pid;
+	return (free_slot);
+}
+
+/**
+ * @brief Releases a session and its message buffer.
+ *
+ * @param session Session to clear (the slot becomes free).
+ */
+void	session_end(t_session *session)
+{
+	free(session->buf);
+	ft_bzero(session, sizeof(t_session));
+}
+
+/**
+ * @brief Appends decoded bytes to the session's message buffer.
+ *
+ * The buffer doubles when full, so a message of n bytes costs O(log n)
+ * allocations.
+ *
+ * @param session Session receiving the bytes.
+ * @param bytes Decoded bytes.
+ * @param n Number of bytes.
+ * @return 1 on success, 0 if the buffer could not grow.
+ */
+int	session_append(t_session *session, const char *bytes, size_t n)
+{
+	char	*grown;
+	size_t	cap;
+
+	if (session->len + n > session->cap)
+	{
+		cap = session->cap * 2 + n + 64;
+		grown = malloc(cap);
+		if (!grown)
+			return (0);
+		if (session->buf)
+			ft_memcpy(grown, session->buf, session->len);
+		free(session->buf);
+		session->buf = grown;
+		session->cap = cap;
+	}
+	ft_memcpy(session->buf + session->len, bytes, n);
+	session->len += n;
+	return (1);
+}
+
+/**
+ * @brief Moves the complete message of a session into a chunk.
+ *
+ * The chunk takes over the buffer and the stripe header, so the message can
+ * be written later (possibly by another thread) after the session is
+ * released.
+ *
+ * @param session Session whose message is complete.
+ * @param chunk Receives the message.
+ */
+void	session_take(t_session *session, t_chunk *chunk)
+{
+	chunk->buf = session->buf;
+	chunk->len = session->len;
+	chunk->stripe = session->stripe;
+	chunk->pid = session->pid;
+	chunk->release = 0;
+	session->buf = NULL;
+	session->len = 0;
+	session->cap = 0;
+}
+
+/**
+ * @brief Server side: answers a client's SIG_HELLO.
+ *
+ * The server keeps the features it also supports and caps the window to
+ * its own share of RLIMIT_SIGPENDING. The answer is queued once, without
+ * backoff: if the client's queue is full it just times out and falls back
+ * to the 1-bit protocol, which is better than stalling every other session.
+ * If no session slot is left, the answer offers no features at all.
+ *
+ * @param server Server state.
+ * @param rec Record of the SIG_HELLO signal.
+ */
+void	answer_hello(t_server *server, t_record *rec)
+{
+	t_session		*session;
+	union sigval	reply;
+	int				window;
+
+	session = session_get(server, rec->pid);
+	window = hello_window(rec->value);
+	if (window > server->window)
+		window = server->window;
+	if (session)
+	{
+		session->features = hello_features(rec->value)
+			& (FEAT_ALL | FEAT_KEEP);
+		reply.sival_int = hello_pack(session->features, window);
+	}
+	else
+		reply.sival_int = hello_pack(0, 1);
+	sigqueue(rec->pid, SIG_HELLO, reply);
+	trace_mark(TRACE_ACK, SIG_HELLO, rec->pid, reply.sival_int);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shm_bonus.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:15:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:42:58 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Maps the shared-memory ring of a client.
+ *
+ * The client creates the segment (it must not exist yet); the server opens
+ * it by the client's PID, known from `si_pid`.
+ *
+ * @param client PID of the client owning the ring.
+ * @param create 1 on the client side, 0 on the server side.
+ * @return The mapped ring, or NULL on failure.
+ */
+t_shm_ring	*shm_map(pid_t client, int create)
+{
+	t_shm_ring	*ring;
+	char		*name;
+	int			fd;
+
+	name = pid_path(SHM_PREFIX, client, "");
+	if (!name)
+		return (NULL);
+	if (create)
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	else
+		fd = shm_open(name, O_RDWR, 0);
+	free(name);
+	if (fd < 0)
+		return (NULL);
+	if (create && ftruncate(fd, sizeof(t_shm_ring)) == -1)
+		ring = MAP_FAILED;
+	else
+		ring = mmap(NULL, sizeof(t_shm_ring), PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+	close(fd);
+	if (ring == MAP_FAILED)
+		return (NULL);
+	return (ring);
+}
+
+/**
+ * @brief Removes the name of a client's ring.
+ *
+ * The mappings stay valid; the segment is freed once both sides unmap it.
+ *
+ * @param client PID of the client owning the ring.
+ */
+void	shm_unlink_ring(pid_t client)
+{
+	char	*name;
+
+	name = pid_path(SHM_PREFIX, client, "");
+	if (name)
+		shm_unlink(name);
+	free(name);
+}
+
+/**
+ * @brief Sleeps until a ring word changes, or for at most SHM_WAIT_NS.
+ *
+ * The futex is shared between processes (no FUTEX_PRIVATE_FLAG). It
+ * returns at once if the word no longer holds `value`, so a wake-up that
+ * happens before the call is never missed. `asleep` is set before the
+ * futex reads the word: a writer that changes the word and then finds
+ * `asleep` clear has changed it before that read (see `shm_wake()`).
+ *
+ * @param word Word to watch.
+ * @param value Value the caller last read.
+ * @param asleep Flag of the sleeping side.
+ * @return 0 if woken or the value changed, -1 on timeout.
+ */
+int	shm_wait(atomic_uint *word, unsigned int value, atomic_uint *asleep)
+{
+	struct timespec	timeout;
+	int				status;
+
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = SHM_WAIT_NS;
+	status = 0;
+	atomic_store(asleep, 1);
+	if (syscall(SYS_futex, word, FUTEX_WAIT, value, &timeout, NULL, 0) == -1
+		&& errno == ETIMEDOUT)
+		status = -1;
+	atomic_store(asleep, 0);
+	return (status);
+}
+
+/**
+ * @brief Wakes the other side if it sleeps on a ring word.
+ *
+ * Called after the word was changed; without a sleeper (the usual case
+ * while the other side spins) no system call is made. The fence orders
+ * the change of the word before the read of the flag.
+ *
+ * @param word Word the other side may be waiting on.
+ * @param asleep Flag of the other side (see `shm_wait()`).
+ */
+void	shm_wake(atomic_uint *word, atomic_uint *asleep)
+{
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load(asleep))
+		syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
@@ -0,0 +1,166 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shm_server_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:15:16 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:11:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Moves the bytes available in the ring to the message buffer.
+ *
+ * `tail` is written by the client and is not trusted: more than
+ * SHM_RING_SIZE bytes available (which is also what a `tail` moved
+ * backwards looks like) would read past the ring, so the ring is then
+ * treated as corrupt and the transfer is aborted (see `shm_finish()`).
+ *
+ * @param shm Shared-memory session.
+ * @return Number of bytes moved, or -1 if the ring is corrupt or the
+ * buffer could not grow.
+ */
+static ssize_t	shm_drain(t_shm_session *shm)
+{
+	unsigned int	head;
+	size_t			avail;
+	size_t			index;
+	size_t			first;
+
+	head = shm->head;
+	avail = (unsigned int)(atomic_load_explicit(&shm->ring->tail,
+				memory_order_acquire) - head);
+	if (avail > SHM_RING_SIZE)
+		return (-1);
+	if (avail == 0)
+		return (0);
+	index = head % SHM_RING_SIZE;
+	first = avail;
+	if (first > SHM_RING_SIZE - index)
+		first = SHM_RING_SIZE - index;
+	if (!session_append(&shm->msg, shm->ring->data + index, first)
+		|| !session_append(&shm->msg, shm->ring->data, avail - first))
+		return (-1);
+	shm->head = head + avail;
+	atomic_store_explicit(&shm->ring->head, shm->head,
+		memory_order_release);
+	shm_wake(&shm->ring->head, &shm->ring->client_asleep);
+	return (avail);
+}
+
+/**
+ * @brief Ends a shared-memory transfer and frees its session.
+ *
+ * A complete message is written and confirmed with SIGUSR1; otherwise
+ * (client gone, corrupt ring or no memory) the partial message is dropped
+ * and the ring is marked aborted, so a client still waiting for room gives
+ * up. Either way the ring is unmapped; the client's session was already
+ * released by `shm_start()`.
+ *
+ * @param shm Shared-memory session.
+ * @param complete 1 if the client closed the ring after its last byte.
+ */
+static void	shm_finish(t_shm_session *shm, int complete)
+{
+	if (complete)
+	{
+		output_write(shm->msg.buf, shm->msg.len);
+		metrics_message(shm->pid, shm->msg.len);
+		kill(shm->pid, SIGUSR1);
+		trace_mark(TRACE_ACK, SIGUSR1, shm->pid, 0);
+	}
+	else
+	{
+		metrics_resync(1);
+		atomic_store(&shm->ring->aborted, 1);
+		shm_wake(&shm->ring->head, &shm->ring->client_asleep);
+	}
+	munmap(shm->ring, sizeof(t_shm_ring));
+	free(shm->msg.buf);
+	free(shm);
+}
+
+/**
+ * @brief Thread draining one client's ring until the client closes it.
+ *
+ * The thread spins SHM_SPIN times on an empty ring before sleeping on
+ * `seq`; every SHM_WAIT_NS asleep it checks that the client still exists.
+ * `closed` is read before draining, so the bytes published before it was
+ * set are always drained before the message is considered complete.
+ *
+ * @param arg Shared-memory session (freed by the thread).
+ * @return Always NULL.
+ */
+static void	*shm_loop(void *arg)
+{
+	t_shm_session	*shm;
+	unsigned int	seq;
+	unsigned int	closed;
+	ssize_t			moved;
+	int				spins;
+
+	shm = arg;
+	spins = 0;
+	while (1)
+	{
+		seq = atomic_load(&shm->ring->seq);
+		closed = atomic_load(&shm->ring->closed);
+		moved = shm_drain(shm);
+		if (moved < 0 || (moved == 0 && closed))
+			break ;
+		if (moved > 0)
+			spins = 0;
+		else if (spins++ >= SHM_SPIN
+			&& shm_wait(&shm->ring->seq, seq, &shm->ring->server_asleep) == -1
+			&& kill(shm->pid, 0) == -1 && errno == ESRCH)
+			break ;
+	}
+	shm_finish(shm, moved == 0 && closed);
+	return (NULL);
+}
+
+/**
+ * @brief Attaches to a client's ring and starts the thread draining it.
+ *
+ * The FRAME_SHM frame is acknowledged either way: `attached` tells the
+ * client whether to use the ring or to fall back to frames. On success
+ * the client's session is released, as the thread owns the transfer. In
+ * FIFO mode the ring is refused, as the thread would complete the message
+ * outside of the admission order.
+ *
+ * @param server Server state.
+ * @param session Session of the client.
+ * @return FEED_ACK.
+ */
+int	shm_start(t_server *server, t_session *session)
+{
+	t_shm_session	*shm;
+	pthread_t		thread;
+
+	if (server->fifo)
+		return (FEED_ACK);
+	shm = ft_calloc(1, sizeof(t_shm_session));
+	if (!shm)
+		return (FEED_ACK);
+	shm->pid = session->pid;
+	shm->ring = shm_map(session->pid, 0);
+	if (shm->ring)
+		atomic_store(&shm->ring->attached, 1);
+	if (!shm->ring || pthread_create(&thread, NULL, shm_loop, shm) != 0)
+	{
+		if (shm->ring)
+		{
+			atomic_store(&shm->ring->attached, 0);
+			munmap(shm->ring, sizeof(t_shm_ring));
+		}
+		free(shm);
+		return (FEED_ACK);
+	}
+	pthread_detach(thread);
+	session_end(session);
+	return (FEED_ACK);
+}
@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sigpending_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:47:32 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Probes RLIMIT_SIGPENDING and raises the soft limit to the hard one.
+ *
+ * Signals queued with `sigqueue()` are counted per user of the receiving
+ * process and checked against the receiver's RLIMIT_SIGPENDING; once it is
+ * exhausted `sigqueue()` fails with EAGAIN.
+ * Raising the soft limit is always allowed up to the hard limit. If the
+ * raise is refused the current soft limit is kept.
+ *
+ * @return The effective soft limit, LONG_MAX if unlimited, 1 if unknown.
+ */
+long	raise_sigpending(void)
+{
+	struct rlimit	lim;
+
+	if (getrlimit(RLIMIT_SIGPENDING, &lim) == -1)
+		return (1);
+	if (lim.rlim_cur != lim.rlim_max)
+	{
+		lim.rlim_cur = lim.rlim_max;
+		if (setrlimit(RLIMIT_SIGPENDING, &lim) == -1)
+			getrlimit(RLIMIT_SIGPENDING, &lim);
+	}
+	if (lim.rlim_cur == RLIM_INFINITY || lim.rlim_cur > LONG_MAX)
+		return (LONG_MAX);
+	return ((long)lim.rlim_cur);
+}
+
+/**
+ * @brief Derives a send window from a queued-signal limit.
+ *
+ * @param limit RLIMIT_SIGPENDING as returned by `raise_sigpending()`.
+ * @return limit / WINDOW_SHARE, clamped to [1, WINDOW_MAX].
+ */
+int	window_size(long limit)
+{
+	long	window;
+
+	window = limit / WINDOW_SHARE;
+	if (window < 1)
+		return (1);
+	if (window > WINDOW_MAX)
+		return (WINDOW_MAX);
+	return ((int)window);
+}
+
+/**
+ * @brief Queues a signal, backing off while the receiver's queue is full.
+ *
+ * `sigqueue()` fails with EAGAIN when the receiver already has
+ * RLIMIT_SIGPENDING signals pending. That is a transient overload, not an
+ * error: the call is retried after an exponential backoff that starts at
+ * BACKOFF_MIN_NS and is capped at BACKOFF_MAX_NS. The signal is traced
+ * once it is queued (TRACE_SEND).
+ *
+ * @param pid Receiver PID.
+ * @param sig Signal number (standard or real-time).
+ * @param value Payload stored in `si_value.sival_int`.
+ * @return 0 on success, -1 on any error other than EAGAIN.
+ */
+int	queue_signal(pid_t pid, int sig, int value)
+{
+	union sigval	val;
+	struct timespec	delay;
+
+	val.sival_int = value;
+	delay.tv_sec = 0;
+	delay.tv_nsec = BACKOFF_MIN_NS;
+	while (sigqueue(pid, sig, val) == -1)
+	{
+		if (errno != EAGAIN)
+			return (-1);
+		nanosleep(&delay, NULL);
+		if (delay.tv_nsec < BACKOFF_MAX_NS)
+			delay.tv_nsec *= 2;
+	}
+	trace_mark(TRACE_SEND, sig, pid, value);
+	return (0);
+}
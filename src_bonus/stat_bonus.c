@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stat_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:58:51 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+#include <dirent.h>
+
+/**
+ * @brief Tells whether a descriptor of the server is its metrics memfd.
+ *
+ * @param dir Path of the server's /proc/<pid>/fd directory.
+ * @param name Name of the descriptor in it.
+ * @return The path of the descriptor (to free), or NULL.
+ */
+static char	*metrics_link(const char *dir, const char *name)
+{
+	char	target[64];
+	char	*path;
+	ssize_t	len;
+
+	path = ft_strjoin(dir, name);
+	if (!path)
+		return (NULL);
+	len = readlink(path, target, sizeof(target) - 1);
+	if (len > 0)
+		target[len] = '\0';
+	if (len <= 0 || ft_strncmp(target, "/memfd:" METRICS_NAME,
+			ft_strlen("/memfd:" METRICS_NAME)) != 0)
+	{
+		free(path);
+		return (NULL);
+	}
+	return (path);
+}
+
+/**
+ * @brief Finds the metrics memfd among the descriptors of a server.
+ *
+ * @param pid PID of the server.
+ * @return Its path under /proc (to free), or NULL if there is none.
+ */
+static char	*metrics_path(pid_t pid)
+{
+	struct dirent	*entry;
+	DIR				*fds;
+	char			*dir;
+	char			*path;
+
+	dir = pid_path("/proc/", pid, "/fd/");
+	if (!dir)
+		return (NULL);
+	fds = opendir(dir);
+	path = NULL;
+	while (fds && !path)
+	{
+		entry = readdir(fds);
+		if (!entry)
+			break ;
+		path = metrics_link(dir, entry->d_name);
+	}
+	if (fds)
+		closedir(fds);
+	free(dir);
+	return (path);
+}
+
+/**
+ * @brief Maps the metrics of a running server, read-only.
+ *
+ * The memfd is opened through /proc/<pid>/fd, which needs the same rights
+ * as tracing the server (normally: the same user). Nothing is sent to the
+ * server, which never notices it is being read.
+ *
+ * @param pid PID of the server (0, for a server that was not found, gives
+ * NULL).
+ * @return The metrics, or NULL if the server has none or cannot be read.
+ */
+t_metrics	*stat_open(pid_t pid)
+{
+	t_metrics	*metrics;
+	struct stat	info;
+	char		*path;
+	int			fd;
+
+	path = metrics_path(pid);
+	if (!path)
+		return (NULL);
+	fd = open(path, O_RDONLY);
+	free(path);
+	if (fd < 0)
+		return (NULL);
+	metrics = MAP_FAILED;
+	if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(t_metrics))
+		metrics = mmap(NULL, sizeof(t_metrics), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (metrics == MAP_FAILED)
+		return (NULL);
+	return (metrics);
+}
+
+/**
+ * @brief Prints a counter on standard output.
+ *
+ * `ft_printf()` only prints 32-bit numbers, and a long-running server
+ * goes past that.
+ *
+ * @param n Number to print.
+ */
+void	stat_number(unsigned long n)
+{
+	if (n >= 10)
+		stat_number(n / 10);
+	ft_putchar_fd('0' + n % 10, 1);
+}
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stat_print_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:58:51 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:10:03 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Prints a duration with a readable unit (ns, us, ms or s).
+ *
+ * @param ns Duration in nanoseconds.
+ */
+static void	put_duration(unsigned long ns)
+{
+	if (ns < 10000)
+		ft_printf("%u ns", (unsigned int)ns);
+	else if (ns < 10000000)
+		ft_printf("%u us", (unsigned int)(ns / 1000));
+	else if (ns < 10000000000UL)
+		ft_printf("%u ms", (unsigned int)(ns / 1000000));
+	else
+	{
+		stat_number(ns / 1000000000);
+		ft_printf(" s");
+	}
+}
+
+/**
+ * @brief Prints the main percentiles of a gap histogram on one line.
+ *
+ * @param gaps Gap histogram.
+ */
+static void	put_percentiles(t_hist *gaps)
+{
+	ft_printf("p50 ");
+	put_duration(ft_hist_percentile(gaps, 5000));
+	ft_printf(", p90 ");
+	put_duration(ft_hist_percentile(gaps, 9000));
+	ft_printf(", p99 ");
+	put_duration(ft_hist_percentile(gaps, 9900));
+	ft_printf(", p99.9 ");
+	put_duration(ft_hist_percentile(gaps, 9990));
+	ft_printf(", max ");
+	put_duration(ft_hist_percentile(gaps, 10000));
+	ft_printf("\n");
+}
+
+/**
+ * @brief Prints a gap histogram: percentiles, then its power-of-two ranges.
+ *
+ * The log-linear buckets of each power-of-two range are added up, which is
+ * precise enough to see how gaps are spread and fits on a screen.
+ *
+ * @param title What the histogram is, printed before it.
+ * @param gaps Gap histogram.
+ */
+void	stat_gaps(const char *title, t_hist *gaps)
+{
+	unsigned long	count;
+	int				range;
+	int				i;
+
+	ft_printf("%s: ", title);
+	put_percentiles(gaps);
+	range = 0;
+	while (range < FT_HIST_BUCKETS >> FT_HIST_SUB_BITS)
+	{
+		count = 0;
+		i = 0;
+		while (i < 1 << FT_HIST_SUB_BITS)
+			count += atomic_load(&gaps->buckets[(range << FT_HIST_SUB_BITS)
+					+ i++]);
+		if (count > 0)
+		{
+			ft_printf("  >= ");
+			put_duration(ft_hist_lower(range << FT_HIST_SUB_BITS));
+			ft_printf("\t");
+			stat_number(count);
+			ft_printf("\n");
+		}
+		range++;
+	}
+}
+
+/**
+ * @brief Prints one line per client holding a row.
+ *
+ * @param metrics Server metrics.
+ */
+static void	print_clients(t_metrics *metrics)
+{
+	t_client_metrics	*row;
+	int					i;
+
+	ft_printf("Clients (pid, signals, bytes, messages, median gap):\n");
+	i = 0;
+	while (i < METRICS_CLIENTS)
+	{
+		row = &metrics->clients[i++];
+		if (atomic_load(&row->pid) == 0)
+			continue ;
+		ft_printf("  %d\t", atomic_load(&row->pid));
+		stat_number(atomic_load(&row->signals));
+		ft_printf("\t");
+		stat_number(atomic_load(&row->bytes));
+		ft_printf("\t");
+		stat_number(atomic_load(&row->messages));
+		ft_printf("\t");
+		put_duration(ft_hist_percentile(&row->gaps, 5000));
+		ft_printf("\n");
+	}
+}
+
+/**
+ * @brief Prints a snapshot of the metrics of a server.
+ *
+ * Each counter is read once; counters updated meanwhile may be one signal
+ * apart from each other, which is fine for monitoring.
+ *
+ * @param metrics Server metrics (see `stat_open()`).
+ */
+void	stat_print(t_metrics *metrics)
+{
+	ft_printf("Server %d, up ", metrics->pid);
+	put_duration(metrics_clock() - metrics->start_ns);
+	ft_printf("\nSignals received: ");
+	stat_number(atomic_load(&metrics->signals));
+	ft_printf("\nBytes decoded: ");
+	stat_number(atomic_load(&metrics->bytes));
+	ft_printf("\nMessages completed: ");
+	stat_number(atomic_load(&metrics->messages));
+	ft_printf("\nResyncs: ");
+	stat_number(atomic_load(&metrics->drops));
+	ft_printf(" dropped signals, ");
+	stat_number(atomic_load(&metrics->aborts));
+	ft_printf(" aborted messages\nActive sessions: %u\n",
+		atomic_load(&metrics->active));
+	stat_gaps("Inter-signal gaps", &metrics->gaps);
+	print_clients(metrics);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stat_save_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 22:09:19 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 22:09:19 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Adds up the gap histograms of a server and of its workers.
+ *
+ * A worker pool (`--workers`) keeps one metrics memfd per process; the
+ * workers are found in the directory the master published (see
+ * `directory_read()`), and each one is mapped only for the merge.
+ *
+ * @param pid PID of the server.
+ * @param pool Histogram receiving the gaps of every process.
+ * @return Number of processes whose gaps were added.
+ */
+int	stat_pool(pid_t pid, t_hist *pool)
+{
+	pid_t		pids[WORKERS_MAX + 1];
+	t_metrics	*metrics;
+	int			count;
+	int			merged;
+
+	pids[0] = pid;
+	count = directory_read(pid, pids + 1) + 1;
+	merged = 0;
+	while (count-- > 0)
+	{
+		metrics = stat_open(pids[count]);
+		if (!metrics)
+			continue ;
+		ft_hist_merge(pool, &metrics->gaps);
+		munmap(metrics, sizeof(t_metrics));
+		merged++;
+	}
+	return (merged);
+}
+
+/**
+ * @brief Writes a gap histogram to a file (`--save`).
+ *
+ * The histogram is serialized with `ft_hist_serialize()`, which takes a
+ * few hundred bytes for a typical run, so it can be kept and compared with
+ * a later run (see `stat_load()`).
+ *
+ * @param path Path of the file (replaced if it exists).
+ * @param hist Histogram to save.
+ * @return 1 on success, 0 on failure.
+ */
+int	stat_save(const char *path, t_hist *hist)
+{
+	unsigned char	buf[METRICS_HIST_SIZE];
+	size_t			len;
+	int				fd;
+	int				done;
+
+	len = ft_hist_serialize(hist, buf, sizeof(buf));
+	if (len == 0)
+		return (0);
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return (0);
+	done = (write(fd, buf, len) == (ssize_t)len);
+	close(fd);
+	return (done);
+}
+
+/**
+ * @brief Reads a gap histogram saved by `stat_save()` (`--load`).
+ *
+ * @param path Path of the file.
+ * @param hist Receives the histogram.
+ * @return 1 on success, 0 if the file cannot be read or is not a
+ * histogram.
+ */
+int	stat_load(const char *path, t_hist *hist)
+{
+	unsigned char	buf[METRICS_HIST_SIZE];
+	ssize_t			len;
+	int				fd;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return (0);
+	len = read(fd, buf, sizeof(buf));
+	close(fd);
+	ft_hist_reset(hist);
+	return (len > 0 && ft_hist_deserialize(hist, buf, len));
+}
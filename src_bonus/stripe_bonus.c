@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stripe_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:59:29 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:37:54 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Returns the reassembly buffer of a striped message.
+ *
+ * Groups are keyed by the PID of the client that forked the workers. The
+ * first stripe to complete allocates the whole message, zeroed, so later
+ * stripes are copied in place at their offset and a client sending
+ * overlapping stripes never prints stale heap memory.
+ *
+ * @param server Server state.
+ * @param stripe Header of the completed stripe.
+ * @return The group, or NULL if the header is invalid, the table is full
+ * or allocation failed.
+ */
+static t_group	*group_get(t_server *server, t_stripe *stripe)
+{
+	t_group	*free_slot;
+	int		i;
+
+	if (stripe->count > STRIPES_MAX || stripe->index >= stripe->count
+		|| stripe->offset > stripe->total)
+		return (NULL);
+	free_slot = NULL;
+	i = 0;
+	while (i < MAX_GROUPS)
+	{
+		if (server->groups[i].id == stripe->group)
+			return (&server->groups[i]);
+		if (!free_slot && server->groups[i].id == 0)
+			free_slot = &server->groups[i];
+		i++;
+	}
+	if (!free_slot)
+		return (NULL);
+	free_slot->buf = ft_calloc(stripe->total + 1, 1);
+	if (!free_slot->buf)
+		return (NULL);
+	free_slot->id = stripe->group;
+	free_slot->count = stripe->count;
+	free_slot->total = stripe->total;
+	return (free_slot);
+}
+
+/**
+ * @brief Releases a group and its buffer, without writing it.
+ *
+ * @param group Group to release.
+ */
+static void	group_drop(t_group *group)
+{
+	free(group->buf);
+	ft_bzero(group, sizeof(t_group));
+}
+
+/**
+ * @brief Writes a reassembled message and releases its group.
+ *
+ * @param group Group whose stripes have all been received.
+ */
+static void	group_flush(t_group *group)
+{
+	output_write(group->buf, group->total);
+	group_drop(group);
+}
+
+/**
+ * @brief Copies a completed stripe into its message.
+ *
+ * Stripes complete in any order; each one lands at its own offset, so the
+ * message comes out ordered once every stripe index has been received.
+ * A stripe is refused when it does not fit its header, when no group can
+ * hold it, or when it disagrees with its group (stripe count or total
+ * length) or repeats an index already received; the group is then dropped,
+ * since the client sends the whole message again without stripes.
+ *
+ * @param server Server state (owner of the group table).
+ * @param chunk Stripe received from one worker.
+ * @return 1 if the stripe was accepted, 0 if it was refused.
+ */
+int	stripe_finish(t_server *server, t_chunk *chunk)
+{
+	t_stripe		*stripe;
+	t_group			*group;
+	unsigned int	bit;
+
+	stripe = &chunk->stripe;
+	group = group_get(server, stripe);
+	if (!group)
+		return (0);
+	bit = 1u << stripe->index;
+	if (group->count != stripe->count || group->total != stripe->total
+		|| chunk->len > stripe->total - stripe->offset
+		|| (group->received & bit))
+	{
+		group_drop(group);
+		return (0);
+	}
+	if (chunk->len > 0)
+		ft_memcpy(group->buf + stripe->offset, chunk->buf, chunk->len);
+	group->received |= bit;
+	if (group->received == (1u << group->count) - 1)
+		group_flush(group);
+	return (1);
+}
+
+/**
+ * @brief Drops the unfinished messages of a client that has exited.
+ *
+ * A parent client killed while its workers were sending would otherwise
+ * hold its group, and one of the MAX_GROUPS slots, forever. Each message
+ * dropped is counted as aborted (see `metrics_resync()`).
+ *
+ * @param server Server state (owner of the group table).
+ * @param pid PID of the client.
+ */
+void	stripe_release(t_server *server, pid_t pid)
+{
+	int	i;
+
+	i = 0;
+	while (i < MAX_GROUPS)
+	{
+		if (server->groups[i].id == pid)
+		{
+			group_drop(&server->groups[i]);
+			metrics_resync(1);
+		}
+		i++;
+	}
+}
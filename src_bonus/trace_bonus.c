@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:06:28 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:18:34 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static t_trace	g_trace;
+
+/**
+ * @brief Writes the trace and the signal log, then lets the signal stop the
+ * process.
+ *
+ * The handler is installed with SA_RESETHAND, so raising the signal again
+ * applies its default action.
+ *
+ * @param sig SIGINT or SIGTERM.
+ */
+static void	dump_stop(int sig)
+{
+	trace_dump();
+	record_flush();
+	raise(sig);
+}
+
+/**
+ * @brief Writes the trace and the signal log when SIGINT or SIGTERM stop
+ * the process.
+ *
+ * Only signals left to their default action are caught: a program that
+ * handles them already writes both itself (see `workers_start()`).
+ */
+void	dump_on_stop(void)
+{
+	struct sigaction	sa;
+	struct sigaction	old;
+
+	ft_bzero(&sa, sizeof(sa));
+	sa.sa_handler = dump_stop;
+	sa.sa_flags = SA_RESETHAND;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(SIGINT, NULL, &old) == 0 && old.sa_handler == SIG_DFL)
+		sigaction(SIGINT, &sa, NULL);
+	if (sigaction(SIGTERM, NULL, &old) == 0 && old.sa_handler == SIG_DFL)
+		sigaction(SIGTERM, &sa, NULL);
+}
+
+/**
+ * @brief Starts tracing this process (`--trace`).
+ *
+ * The event buffer is mapped once, before the first signal, and only
+ * faulted in as it fills, so recording an event never allocates. The trace
+ * is written by `exit()` or when SIGINT or SIGTERM stop the process, which
+ * is how a server ends (see `trace_dump()`). A process forked by a traced
+ * one calls this again under its own name: it empties the copy of the
+ * buffer it inherited and writes a file of its own. A process that cannot
+ * map the buffer runs untraced.
+ *
+ * @param name Name of the process in the trace viewer.
+ */
+void	trace_start(const char *name)
+{
+	t_trace_event	*events;
+
+	if (!g_trace.events)
+	{
+		events = mmap(NULL, TRACE_EVENTS * sizeof(t_trace_event),
+				PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (events == MAP_FAILED)
+			return ;
+		atexit(trace_dump);
+		g_trace.events = events;
+	}
+	free(g_trace.path);
+	g_trace.pid = getpid();
+	g_trace.path = pid_path(DIRECTORY_PREFIX, g_trace.pid, TRACE_SUFFIX);
+	g_trace.name = name;
+	atomic_store(&g_trace.count, 0);
+	atomic_store(&g_trace.dumped, 0);
+	dump_on_stop();
+}
+
+/**
+ * @brief Returns the trace of this process.
+ *
+ * @return The trace (`events` is NULL when not tracing, and every
+ * `trace_*()` call then does nothing).
+ */
+t_trace	*trace_get(void)
+{
+	return (&g_trace);
+}
@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_dump_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:06:40 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+static char		g_out[65536];
+static size_t	g_out_len;
+
+/**
+ * @brief Appends a string to the trace file, through `g_out`.
+ *
+ * @param fd Trace file.
+ * @param str String to append (NULL flushes `g_out`).
+ */
+static void	put_str(int fd, const char *str)
+{
+	ssize_t	written;
+
+	while (!str || *str)
+	{
+		if (!str || g_out_len == sizeof(g_out))
+		{
+			written = write(fd, g_out, g_out_len);
+			(void)written;
+			g_out_len = 0;
+			if (!str)
+				return ;
+		}
+		g_out[g_out_len++] = *str++;
+	}
+}
+
+/**
+ * @brief Appends a number in decimal to the trace file.
+ *
+ * @param fd Trace file.
+ * @param n Number to append.
+ * @param decimals Digits of `n` after the decimal point.
+ */
+static void	put_number(int fd, long n, int decimals)
+{
+	char			digits[32];
+	unsigned long	u;
+	int				i;
+	int				len;
+
+	u = n;
+	if (n < 0)
+		u = -(unsigned long)n;
+	i = 31;
+	digits[i] = '\0';
+	len = 0;
+	while (u || len <= decimals)
+	{
+		if (decimals && len == decimals)
+			digits[--i] = '.';
+		digits[--i] = '0' + u % 10;
+		u /= 10;
+		len++;
+	}
+	if (n < 0)
+		digits[--i] = '-';
+	put_str(fd, digits + i);
+}
+
+/**
+ * @brief Appends the arguments of an instant event: its signal.
+ *
+ * @param fd Trace file.
+ * @param event Instant event.
+ */
+static void	put_args(int fd, t_trace_event *event)
+{
+	put_str(fd, ",\"s\":\"t\",\"args\":{\"sig\":");
+	put_number(fd, event->sig, 0);
+	put_str(fd, ",\"peer\":");
+	put_number(fd, event->peer, 0);
+	put_str(fd, ",\"value\":");
+	put_number(fd, event->value, 0);
+	put_str(fd, "}");
+}
+
+/**
+ * @brief Appends one event, with its timestamp in microseconds.
+ *
+ * @param fd Trace file.
+ * @param event Event to append.
+ * @param pid PID of this process.
+ */
+static void	put_event(int fd, t_trace_event *event, pid_t pid)
+{
+	static const char	*names[] = {"send", "deliver", "handler", "ack",
+		"write"};
+	char				phase[2];
+
+	phase[0] = event->phase;
+	phase[1] = '\0';
+	put_str(fd, ",\n{\"name\":\"");
+	put_str(fd, names[event->kind]);
+	put_str(fd, "\",\"cat\":\"minitalk\",\"ph\":\"");
+	put_str(fd, phase);
+	put_str(fd, "\",\"ts\":");
+	put_number(fd, event->ts_ns, 3);
+	put_str(fd, ",\"pid\":");
+	put_number(fd, pid, 0);
+	put_str(fd, ",\"tid\":");
+	put_number(fd, event->tid, 0);
+	if (event->phase == 'i')
+		put_args(fd, event);
+	put_str(fd, "}");
+}
+
+/**
+ * @brief Writes the trace of this process as Chrome trace JSON.
+ *
+ * The file, DIRECTORY_PREFIX<pid>TRACE_SUFFIX, opens in chrome://tracing
+ * or ui.perfetto.dev. Only `open()`, `write()` and `close()` are called,
+ * so it is safe from a signal handler; the trace is written once, and only
+ * by the process that started it (not by a child that inherited it).
+ * Events lost to a full buffer are counted in `otherData.dropped`.
+ */
+void	trace_dump(void)
+{
+	t_trace			*trace;
+	unsigned int	i;
+	int				fd;
+
+	trace = trace_get();
+	if (!trace->events || !trace->path || trace->pid != getpid()
+		|| atomic_exchange(&trace->dumped, 1))
+		return ;
+	fd = open(trace->path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return ;
+	put_str(fd, "{\"traceEvents\":[\n"
+		"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":");
+	put_number(fd, trace->pid, 0);
+	put_str(fd, ",\"args\":{\"name\":\"");
+	put_str(fd, trace->name);
+	put_str(fd, "\"}}");
+	i = 0;
+	while (i < TRACE_EVENTS && i < atomic_load(&trace->count))
+		put_event(fd, &trace->events[i++], trace->pid);
+	put_str(fd, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":");
+	put_number(fd, atomic_load(&trace->count) - i, 0);
+	put_str(fd, "}}\n");
+	put_str(fd, NULL);
+	close(fd);
+}
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_event_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:06:28 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:09:18 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Takes the next slot of the trace and stamps it.
+ *
+ * Slots are handed out with one atomic add, so threads and signal handlers
+ * record concurrently without a lock. The clock is CLOCK_MONOTONIC, shared
+ * by every process: the traces of a client and a server line up.
+ *
+ * @param kind Kind of event (TRACE_*).
+ * @param phase Chrome trace phase ('i', 'B' or 'E').
+ * @return The slot, or NULL when not tracing or the buffer is full.
+ */
+static t_trace_event	*trace_slot(int kind, int phase)
+{
+	t_trace			*trace;
+	t_trace_event	*event;
+	struct timespec	now;
+	unsigned int	i;
+
+	trace = trace_get();
+	if (!trace->events)
+		return (NULL);
+	i = atomic_fetch_add_explicit(&trace->count, 1, memory_order_relaxed);
+	if (i >= TRACE_EVENTS)
+		return (NULL);
+	event = &trace->events[i];
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	event->ts_ns = now.tv_sec * 1000000000L + now.tv_nsec;
+	event->tid = syscall(SYS_gettid);
+	event->kind = kind;
+	event->phase = phase;
+	event->sig = 0;
+	event->peer = 0;
+	event->value = 0;
+	return (event);
+}
+
+/**
+ * @brief Records an instant event about one signal.
+ *
+ * @param kind TRACE_SEND, TRACE_DELIVER or TRACE_ACK.
+ * @param sig Signal number.
+ * @param peer PID of the process at the other end.
+ * @param value Queued value of the signal (0 if none).
+ */
+void	trace_mark(int kind, int sig, pid_t peer, int value)
+{
+	t_trace_event	*event;
+
+	event = trace_slot(kind, 'i');
+	if (!event)
+		return ;
+	event->sig = sig;
+	event->peer = peer;
+	event->value = value;
+}
+
+/**
+ * @brief Records the begin or the end of a span.
+ *
+ * Spans nest per thread, as Chrome trace 'B' and 'E' events do.
+ *
+ * @param kind TRACE_HANDLER or TRACE_WRITE.
+ * @param begin 1 at the beginning of the span, 0 at its end.
+ */
+void	trace_span(int kind, int begin)
+{
+	if (begin)
+		trace_slot(kind, 'B');
+	else
+		trace_slot(kind, 'E');
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   workers_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:05:41 by maria-ol          #+#    #+#             */
+/*   Updated: 2026/10/18 21:18:34 by maria-ol         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "includes/minitalk_bonus.h"
+
+/**
+ * @brief Worker pool of the master server (empty in the workers).
+ */
+static t_workers	g_workers;
+
+/**
+ * @brief Master side: stops the pool on SIGINT or SIGTERM.
+ *
+ * The workers are terminated and the directory is removed, so clients
+ * started afterwards talk to no stale worker. The trace and the signal log
+ * of the master are written (see `trace_dump()` and `record_flush()`).
+ *
+ * @param sig Signal number (unused).
+ */
+static void	stop_workers(int sig)
+{
+	int	i;
+
+	(void)sig;
+	i = 0;
+	while (i < g_workers.count)
+		kill(g_workers.pids[i++], SIGTERM);
+	if (g_workers.path)
+		unlink(g_workers.path);
+	trace_dump();
+	record_flush();
+	_exit(0);
+}
+
+/**
+ * @brief Worker side: detaches the worker from the master's pool.
+ *
+ * A worker is terminated with its master (PR_SET_PDEATHSIG), even if the
+ * master is killed without a chance to clean up. Only the master
+ * publishes its PID (see `server_publish()`). Memory locks are not
+ * inherited, so a prewarmed worker warms up again. A recording worker logs
+ * to a file of its own (see `record_path()`).
+ *
+ * @param server Server state inherited from the master.
+ * @param master PID of the master server.
+ * @return Always 1 (the worker goes on as a regular server).
+ */
+static int	worker_init(t_server *server, pid_t master)
+{
+	prctl(PR_SET_PDEATHSIG, SIGTERM);
+	if (getppid() != master)
+		_exit(0);
+	if (server->ready_fd >= 0)
+		close(server->ready_fd);
+	server->ready_fd = -1;
+	free(server->pidfile);
+	server->pidfile = NULL;
+	if (server->prewarm)
+		prewarm(server);
+	if (server->record)
+		server->record = record_path(server->record, getpid());
+	free(g_workers.path);
+	ft_bzero(&g_workers, sizeof(t_workers));
+	return (1);
+}
+
+/**
+ * @brief Forks the worker servers and publishes their PIDs.
+ *
+ * Called after `setup_signals()`: the workers inherit the blocked signals
+ * and their handlers, and go on serving clients exactly like the master.
+ * The master keeps serving the clients that address it directly, such as
+ * the mandatory client, which does not read the directory.
+ *
+ * @param server Server state (`workers` is the size of the pool).
+ * @return 1 on success (in the master and in every worker), 0 on failure.
+ */
+int	workers_start(t_server *server)
+{
+	struct sigaction	sa;
+	pid_t				master;
+	pid_t				pid;
+
+	master = getpid();
+	g_workers.path = pid_path(DIRECTORY_PREFIX, master, ".workers");
+	if (!g_workers.path)
+		return (0);
+	while (g_workers.count < server->workers)
+	{
+		pid = fork();
+		if (pid == -1)
+			return (0);
+		if (pid == 0)
+			return (worker_init(server, master));
+		g_workers.pids[g_workers.count++] = pid;
+	}
+	ft_bzero(&sa, sizeof(sa));
+	sa.sa_handler = stop_workers;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	signal(SIGCHLD, SIG_IGN);
+	return (directory_publish(g_workers.path, g_workers.pids,
+			g_workers.count));
+}